@@ -88,7 +88,8 @@ void Run(const std::string& name, const RunnerOpts& opts) {
 	/* Determine number of resources and set data/export folder paths */
 	PCS_INFO(fmt::format(fmt::fg(fmt::color::white_smoke), "Using {} Example", name));
 	std::string data_folder = "../../data/" + name + '/';
-	std::string export_folder = "../../exports/" + name + (opts.incremental_topology ? "/incremental/" : "/complete/");
+	std::string export_folder = "../../exports/" + name + (opts.adaptive_topology ? "/adaptive/"
+		: opts.incremental_topology ? "/incremental/" : "/complete/");
 	size_t num_resources = NumOfResources(data_folder);
 
 	/* Load everything */
@@ -96,7 +97,18 @@ void Run(const std::string& name, const RunnerOpts& opts) {
 	pcs::ExportToFile(recipe.lts(), export_folder + "/recipe.txt");
 
 	pcs::Environment machine = LoadMachine(data_folder, num_resources);
-	if (opts.incremental_topology) {
+	if (opts.prune_resources) {
+		machine.PruneResources();
+	}
+	if (opts.minimize_resources) {
+		machine.MinimizeResources();
+	}
+	if (opts.cache_topology) {
+		machine.set_topology_cache("../../exports/cache/");
+	}
+	if (opts.adaptive_topology) {
+		machine.Adaptive(recipe);
+	} else if (opts.incremental_topology) {
 		IncrementalTopology(machine);
 	} else {
 		CompleteTopology(machine);
@@ -114,7 +126,7 @@ void Run(const std::string& name, const RunnerOpts& opts) {
 
 	/* Export machine, print incremenetal topology stats, and generate images */
 	pcs::ExportEnvironment(machine, export_folder);
-	if (opts.incremental_topology) {
+	if (opts.incremental_topology || opts.adaptive_topology) {
 		PCS_INFO(fmt::format(fmt::fg(fmt::color::white_smoke), "[Topology] Number Of States = {}, Number of Transitions = {}", machine.topology()->lts().NumOfStates(),
 			machine.topology()->lts().NumOfTransitions()));
 	}
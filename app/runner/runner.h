@@ -9,8 +9,12 @@
 
 struct RunnerOpts {
 	bool incremental_topology;
+	bool adaptive_topology; // Chooses complete, incremental or generator topology from the resources and recipe, overrides incremental_topology
 	bool generate_images;
 	bool only_highlighted_topology_image; // Exports the highlighted topology only, rather than topology & highlighted topology
+	bool cache_topology; // Reuses a complete topology from exports/cache/ whilst the resources remain unchanged
+	bool prune_resources; // Removes dead transfers, unreachable local states and nop self-loops before computing the topology
+	bool minimize_resources; // Replaces each resource by its strong bisimulation quotient before computing the topology
 };
 
 void Run(const std::string& name, const RunnerOpts& opts);
@@ -28,6 +28,30 @@ static void HingeCompleteTopology(benchmark::State& state) {
 
 BENCHMARK(HingeCompleteTopology)->Unit(benchmark::kMillisecond);
 
+static void HingeCachedCompleteTopology(benchmark::State& state) {
+	// The time to map a previously computed complete topology from the on-disk cache
+	pcs::Environment machine;
+	try {
+		machine.AddResource("../../data/hinge/Resource1.txt", false);
+		machine.AddResource("../../data/hinge/Resource2.txt", false);
+		machine.AddResource("../../data/hinge/Resource3.txt", false);
+		machine.AddResource("../../data/hinge/Resource4.txt", false);
+		machine.AddResource("../../data/hinge/Resource5.txt", false);
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+	machine.set_topology_cache("../../exports/cache/");
+	machine.Complete();
+
+	for (auto _ : state) {
+		machine.Complete();
+		benchmark::DoNotOptimize(machine.topology());
+		benchmark::ClobberMemory();
+	}
+}
+
+BENCHMARK(HingeCachedCompleteTopology)->Unit(benchmark::kMillisecond);
+
 static void HingeControllerUsingComplete(benchmark::State& state) {
 	// First generate the topology, then time how long the controller takes
 	pcs::Environment machine;
@@ -60,6 +84,105 @@ static void HingeControllerUsingComplete(benchmark::State& state) {
 
 BENCHMARK(HingeControllerUsingComplete)->Unit(benchmark::kMillisecond);
 
+static void HingeControllerSearchModes(benchmark::State& state) {
+	// Controller time over the complete topology per search mode: depth first, breadth first, A*, cheapest and speculative
+	pcs::Environment machine;
+	try {
+		machine.AddResource("../../data/hinge/Resource1.txt", false);
+		machine.AddResource("../../data/hinge/Resource2.txt", false);
+		machine.AddResource("../../data/hinge/Resource3.txt", false);
+		machine.AddResource("../../data/hinge/Resource4.txt", false);
+		machine.AddResource("../../data/hinge/Resource5.txt", false);
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	pcs::Recipe recipe;
+	try {
+		recipe.set_recipe("../../data/hinge/recipe.json");
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	machine.Complete();
+
+	size_t expansions = 0;
+	for (auto _ : state) {
+		pcs::Controller con(&machine, machine.topology(), &recipe, { .memoise = false, .search = static_cast<pcs::SearchMode>(state.range(0)) });
+		auto controller_lts = con.Generate();
+		expansions = con.NumOfExpansions();
+		benchmark::DoNotOptimize(controller_lts);
+		benchmark::ClobberMemory();
+	}
+	state.counters["expansions"] = static_cast<double>(expansions);
+}
+
+BENCHMARK(HingeControllerSearchModes)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Arg(4)->Unit(benchmark::kMillisecond);
+
+static void HingeControllerThreads(benchmark::State& state) {
+	// Controller time over the complete topology with the recipe branches explored by the given number of threads
+	pcs::Environment machine;
+	try {
+		machine.AddResource("../../data/hinge/Resource1.txt", false);
+		machine.AddResource("../../data/hinge/Resource2.txt", false);
+		machine.AddResource("../../data/hinge/Resource3.txt", false);
+		machine.AddResource("../../data/hinge/Resource4.txt", false);
+		machine.AddResource("../../data/hinge/Resource5.txt", false);
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	pcs::Recipe recipe;
+	try {
+		recipe.set_recipe("../../data/hinge/recipe.json");
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	machine.Complete();
+
+	for (auto _ : state) {
+		pcs::Controller con(&machine, machine.topology(), &recipe, { .memoise = false, .threads = static_cast<size_t>(state.range(0)) });
+		auto controller_lts = con.Generate();
+		benchmark::DoNotOptimize(controller_lts);
+		benchmark::ClobberMemory();
+	}
+}
+
+BENCHMARK(HingeControllerThreads)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void HingeControllerDecide(benchmark::State& state) {
+	// Realisability decisions over the complete topology, repeated on one controller so the memoised searches are reused
+	pcs::Environment machine;
+	try {
+		machine.AddResource("../../data/hinge/Resource1.txt", false);
+		machine.AddResource("../../data/hinge/Resource2.txt", false);
+		machine.AddResource("../../data/hinge/Resource3.txt", false);
+		machine.AddResource("../../data/hinge/Resource4.txt", false);
+		machine.AddResource("../../data/hinge/Resource5.txt", false);
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	pcs::Recipe recipe;
+	try {
+		recipe.set_recipe("../../data/hinge/recipe.json");
+	} catch (const std::ifstream::failure& e) {
+		throw;
+	}
+
+	machine.Complete();
+
+	pcs::Controller con(&machine, machine.topology(), &recipe);
+	for (auto _ : state) {
+		pcs::Realisability result = con.Decide();
+		benchmark::DoNotOptimize(result);
+		benchmark::ClobberMemory();
+	}
+}
+
+BENCHMARK(HingeControllerDecide)->Unit(benchmark::kMillisecond);
+
 
 static void HingeCompleteWithController(benchmark::State& state) {
 	// Times complete + controller total time
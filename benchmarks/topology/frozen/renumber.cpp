@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+#include "pcs/topology/renumber.h"
+
+#include <list>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+#include "pcs/environment/environment.h"
+#include "pcs/controller/controller.h"
+#include "pcs/topology/frozen.h"
+
+// Replays the states visited by Controller::Generate over frozen topologies laid out in different orders. Each
+// visit reads the state's key and edge list and the keys of its successors, as a search over state ids would.
+// Besides wall time, misses of a small fully associative LRU cache of 64 byte lines are modelled over the same
+// accesses, since the data sets fit in a real L2.
+
+namespace {
+
+	/*
+	 * @brief Forwards to a frozen topology and records which states are queried.
+	 */
+	class TracingTopology : public pcs::ITopology {
+	private:
+		pcs::FrozenTopology& topology_;
+	public:
+		std::vector<pcs::FrozenTopology::StateId> trace;
+
+		TracingTopology(pcs::FrozenTopology& topology) : topology_(topology) {}
+
+		const pcs::FrozenTopology::TopologyLTS& lts() const override {
+			return topology_.lts();
+		}
+
+		const std::vector<std::string>& initial_state() const override {
+			return topology_.initial_state();
+		}
+
+		const pcs::State<std::vector<std::string>, std::pair<size_t, std::string>>& at(const std::vector<std::string>& key) override {
+			trace.emplace_back(*topology_.Find(key));
+			return topology_.at(key);
+		}
+	};
+
+	class LruCache {
+	private:
+		size_t capacity_;
+		std::list<uintptr_t> lines_;
+		std::unordered_map<uintptr_t, std::list<uintptr_t>::iterator> where_;
+	public:
+		size_t misses = 0;
+		size_t accesses = 0;
+
+		LruCache(size_t capacity) : capacity_(capacity) {}
+
+		void Touch(const void* address, size_t bytes) {
+			uintptr_t first = reinterpret_cast<uintptr_t>(address) / 64;
+			uintptr_t last = (reinterpret_cast<uintptr_t>(address) + bytes - 1) / 64;
+			for (uintptr_t line = first; line <= last; ++line) {
+				++accesses;
+				auto it = where_.find(line);
+				if (it != where_.end()) {
+					lines_.splice(lines_.begin(), lines_, it->second);
+					continue;
+				}
+				++misses;
+				lines_.push_front(line);
+				where_[line] = lines_.begin();
+				if (lines_.size() > capacity_) {
+					where_.erase(lines_.back());
+					lines_.pop_back();
+				}
+			}
+		}
+	};
+
+	struct Layout {
+		std::unique_ptr<pcs::FrozenTopology> topology;
+		std::vector<pcs::FrozenTopology::StateId> trace;
+	};
+
+	/*
+	 * @brief Freezes the complete topology of a data set and records the controller's trace over it, then renumbers
+	 * it (range -1 keeps the hash order of the complete topology).
+	 */
+	Layout Prepare(const std::string& folder, int order) {
+		pcs::Environment machine;
+		for (int i = 1; i <= 5; ++i) {
+			machine.AddResource("../../data/" + folder + "/Resource" + std::to_string(i) + ".txt", false);
+		}
+		machine.Complete();
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+		auto frozen = std::make_unique<pcs::FrozenTopology>(machine.topology()->lts());
+		TracingTopology tracing(*frozen);
+		pcs::Controller controller(&machine, &tracing, &recipe);
+		controller.Generate();
+
+		Layout layout{ std::move(frozen), std::move(tracing.trace) };
+		if (order >= 0) {
+			std::vector<pcs::FrozenTopology::StateId> ordering = pcs::StateOrdering(*layout.topology, static_cast<pcs::StateOrder>(order));
+			std::vector<pcs::FrozenTopology::StateId> renamed(ordering.size());
+			for (pcs::FrozenTopology::StateId i = 0; i < ordering.size(); ++i) {
+				renamed[ordering[i]] = i;
+			}
+			for (auto& id : layout.trace) {
+				id = renamed[id];
+			}
+			layout.topology = layout.topology->Permute(ordering);
+		}
+		return layout;
+	}
+
+	template <typename TouchF>
+	size_t Replay(const pcs::FrozenTopology& topology, const std::vector<pcs::FrozenTopology::StateId>& trace, TouchF&& touch) {
+		const auto* header = reinterpret_cast<const pcs::FrozenTopology::Header*>(topology.bytes().data());
+		const uint32_t* keys = reinterpret_cast<const uint32_t*>(topology.bytes().data() + header->keys);
+		const size_t row = topology.NumOfResources();
+		size_t sum = 0;
+		for (auto id : trace) {
+			touch(keys + id * row, row * sizeof(uint32_t));
+			auto edges = topology.Edges(id);
+			touch(edges.data(), edges.size_bytes());
+			for (const auto& e : edges) {
+				const uint32_t* target = keys + static_cast<size_t>(e.to) * row;
+				touch(target, row * sizeof(uint32_t));
+				sum += target[e.resource];
+			}
+		}
+		return sum;
+	}
+
+}
+
+static void BM_RenumberedReplay(benchmark::State& state, const std::string& folder) {
+	Layout layout = Prepare(folder, static_cast<int>(state.range(0)));
+	const size_t repetitions = static_cast<size_t>(state.range(1));
+
+	for (auto _ : state) {
+		for (size_t i = 0; i < repetitions; ++i) {
+			benchmark::DoNotOptimize(Replay(*layout.topology, layout.trace, [](const void*, size_t) {}));
+		}
+	}
+
+	LruCache cache(64);
+	Replay(*layout.topology, layout.trace, [&](const void* address, size_t bytes) {
+		if (bytes > 0) {
+			cache.Touch(address, bytes);
+		}
+	});
+	pcs::LocalityStats locality = pcs::MeasureLocality(*layout.topology);
+	state.counters["visits"] = static_cast<double>(layout.trace.size());
+	state.counters["modelled_misses"] = static_cast<double>(cache.misses);
+	state.counters["miss_rate"] = static_cast<double>(cache.misses) / static_cast<double>(cache.accesses);
+	state.counters["mean_distance"] = locality.mean_distance;
+	state.counters["near_fraction"] = locality.near_fraction;
+}
+
+// range(0): -1 hash order, 0 breadth first, 1 depth first, 2 reverse Cuthill-McKee; range(1): replays per iteration
+BENCHMARK_CAPTURE(BM_RenumberedReplay, hinge, std::string("hinge"))->ArgsProduct({ { -1, 0, 1, 2 }, { 1000 } })->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RenumberedReplay, pad, std::string("pad"))->ArgsProduct({ { -1, 0, 1, 2 }, { 1000 } })->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include "pcs/topology/generator.h"
+
+#include <vector>
+
+#include "pcs/lts/parsers/string_string.h"
+
+static void BM_GeneratorExploreRange(benchmark::State& state) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss;
+    ltss.resize(state.range(0));
+    for (size_t i = 0; i < state.range(0); ++i) {
+        pcs::ReadFromFile(ltss[i], "../../data/pad/Resource1.txt");
+    }
+
+    for (auto _ : state) {
+        pcs::GeneratorTopology topology(ltss);
+        pcs::ExplorationStats stats = topology.Explore();
+        benchmark::DoNotOptimize(stats);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_GeneratorExploreRange)->Arg(6)->Iterations(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_GeneratorExploreBitstateRange(benchmark::State& state) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss;
+    ltss.resize(state.range(0));
+    for (size_t i = 0; i < state.range(0); ++i) {
+        pcs::ReadFromFile(ltss[i], "../../data/pad/Resource1.txt");
+    }
+
+    pcs::ExplorationStats stats;
+    for (auto _ : state) {
+        pcs::GeneratorTopology topology(ltss);
+        pcs::BitStateSet visited(1 << 20);
+        stats = topology.Explore(visited);
+        benchmark::DoNotOptimize(stats);
+        benchmark::ClobberMemory();
+    }
+    state.counters["states"] = static_cast<double>(stats.states);
+    state.counters["coverage"] = stats.coverage;
+}
+
+BENCHMARK(BM_GeneratorExploreBitstateRange)->Arg(6)->Iterations(1000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
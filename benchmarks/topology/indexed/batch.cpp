@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include "pcs/topology/indexed.h"
+
+#include <vector>
+
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/static.h"
+
+// Expands every reachable state of range(0) copies of the pad resource, one state at a time or as a single block
+
+static std::vector<pcs::LTS<std::string, std::string>> PadResources(size_t count) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss;
+    ltss.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        pcs::ReadFromFile(ltss[i], "../../data/pad/Resource1.txt");
+    }
+    return ltss;
+}
+
+static pcs::StateBlock ReachableStates(const std::vector<pcs::LTS<std::string, std::string>>& ltss) {
+    pcs::StaticTopology<6> topology(ltss, false);
+    pcs::StateBlock block(ltss.size());
+    for (uint32_t id = 0; id < topology.NumOfStates(); ++id) {
+        block.push_back(topology.key(id).data());
+    }
+    return block;
+}
+
+static void BM_ExpandSingle(benchmark::State& state) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss = PadResources(6);
+    pcs::IndexedResources indexed(ltss);
+    pcs::StateBlock block = ReachableStates(ltss);
+    std::vector<uint32_t> key(ltss.size());
+    std::vector<uint32_t> targets;
+
+    for (auto _ : state) {
+        targets.clear();
+        for (size_t i = 0; i < block.size(); ++i) {
+            block.Row(i, key.data());
+            indexed.ForEachSuccessor(key.data(), [&](size_t resource, uint32_t, uint32_t to, size_t partner, uint32_t partner_to) {
+                size_t base = targets.size();
+                targets.insert(targets.end(), key.begin(), key.end());
+                targets[base + resource] = to;
+                if (partner != pcs::IndexedResources::kNone) {
+                    targets[base + partner] = partner_to;
+                }
+            });
+        }
+        benchmark::DoNotOptimize(targets.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["states"] = static_cast<double>(block.size());
+}
+
+BENCHMARK(BM_ExpandSingle)->Unit(benchmark::kMillisecond);
+
+static void BM_ExpandBatch(benchmark::State& state) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss = PadResources(6);
+    pcs::IndexedResources indexed(ltss);
+    pcs::StateBlock block = ReachableStates(ltss);
+    pcs::EdgeBlock edges(ltss.size());
+
+    for (auto _ : state) {
+        edges.clear();
+        indexed.ExpandBatch(block, edges);
+        benchmark::DoNotOptimize(edges.targets.columns.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["states"] = static_cast<double>(block.size());
+    state.counters["edges"] = static_cast<double>(edges.size());
+}
+
+BENCHMARK(BM_ExpandBatch)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+#include "pcs/topology/static.h"
+
+#include <vector>
+
+#include "pcs/lts/parsers/string_string.h"
+
+static void BM_StaticTopologyRange(benchmark::State& state) {
+    std::vector<pcs::LTS<std::string, std::string>> ltss;
+    ltss.resize(state.range(0));
+    for (size_t i = 0; i < state.range(0); ++i) {
+        pcs::ReadFromFile(ltss[i], "../../data/pad/Resource1.txt");
+    }
+
+    for (auto _ : state) {
+        std::unique_ptr<pcs::ITopology> topology = pcs::MakeStaticTopology(ltss, false);
+        benchmark::DoNotOptimize(topology);
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_StaticTopologyRange)->Arg(6)->Iterations(1000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
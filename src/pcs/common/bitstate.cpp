@@ -0,0 +1,121 @@
+#include "pcs/common/bitstate.h"
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "pcs/common/hash.h"
+
+namespace pcs {
+
+	/**
+	 * @param bytes: size of the bit array, rounded down to a power of two (minimum 8 bytes)
+	 * @param hashes: number of bits set per state, derived from the state hash by double hashing
+	 */
+	BitStateSet::BitStateSet(size_t bytes, size_t hashes)
+		: hashes_(std::max<size_t>(1, hashes)) {
+		size_t words = 1;
+		while (words * 2 * sizeof(uint64_t) <= bytes) {
+			words *= 2;
+		}
+		words_.assign(words, 0);
+		mask_ = words * 64 - 1;
+	}
+
+	/**
+	 * @return True if at least one of the state's bits was unset, i.e. the state is (probably) new
+	 */
+	bool BitStateSet::Insert(uint64_t hash) {
+		const double omission = OmissionProbability();
+		uint64_t step = Mix64(hash) | 1;
+		bool inserted = false;
+		for (size_t i = 0; i < hashes_; ++i, hash += step) {
+			uint64_t bit = hash & mask_;
+			uint64_t& word = words_[bit >> 6];
+			uint64_t flag = uint64_t{ 1 } << (bit & 63);
+			if ((word & flag) == 0) {
+				word |= flag;
+				++set_bits_;
+				inserted = true;
+			}
+		}
+		if (inserted) {
+			++inserted_;
+			// Each new state had this chance of being lost as a false positive instead
+			expected_omissions_ += omission;
+		}
+		return inserted;
+	}
+
+	bool BitStateSet::Contains(uint64_t hash) const {
+		uint64_t step = Mix64(hash) | 1;
+		for (size_t i = 0; i < hashes_; ++i, hash += step) {
+			uint64_t bit = hash & mask_;
+			if ((words_[bit >> 6] & (uint64_t{ 1 } << (bit & 63))) == 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void BitStateSet::Clear() {
+		std::fill(words_.begin(), words_.end(), 0);
+		inserted_ = 0;
+		set_bits_ = 0;
+		expected_omissions_ = 0.0;
+	}
+
+	size_t BitStateSet::NumOfBits() const {
+		return words_.size() * 64;
+	}
+
+	size_t BitStateSet::NumOfHashes() const {
+		return hashes_;
+	}
+
+	size_t BitStateSet::NumOfInserted() const {
+		return inserted_;
+	}
+
+	size_t BitStateSet::NumOfSetBits() const {
+		return set_bits_;
+	}
+
+	size_t BitStateSet::bytes() const {
+		return words_.size() * sizeof(uint64_t);
+	}
+
+	double BitStateSet::FillRatio() const {
+		return static_cast<double>(set_bits_) / static_cast<double>(NumOfBits());
+	}
+
+	/*
+	 * @brief Probability that a state which has not been seen is mistaken for a visited one at the current fill.
+	 */
+	double BitStateSet::OmissionProbability() const {
+		return std::pow(FillRatio(), static_cast<double>(hashes_));
+	}
+
+	/*
+	 * @brief Number of distinct states inserted, estimated from the number of set bits.
+	 */
+	double BitStateSet::EstimatedStates() const {
+		const double m = static_cast<double>(NumOfBits());
+		if (set_bits_ >= NumOfBits()) {
+			return static_cast<double>(inserted_);
+		}
+		return -m / static_cast<double>(hashes_) * std::log1p(-FillRatio());
+	}
+
+	/**
+	 * @brief Estimated fraction of the encountered distinct states which were explored rather than omitted by hash
+	 * collisions. States below an omitted state are not accounted for, so treat this as an upper bound on coverage.
+	 */
+	double BitStateSet::Coverage() const {
+		if (inserted_ == 0) {
+			return 1.0;
+		}
+		return static_cast<double>(inserted_) / (static_cast<double>(inserted_) + expected_omissions_);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace pcs {
+
+	/**
+	 * @brief Bitstate (supertrace) visited set: states are reduced to a 64-bit hash and recorded as k bits in a fixed
+	 * size bit array, instead of being stored. Membership is approximate: a new state whose bits are already all set
+	 * is wrongly treated as visited and its subtree is skipped, so exploration may be incomplete but never reports
+	 * a state which is not reachable. Memory is fixed at construction.
+	 */
+	class BitStateSet {
+	private:
+		std::vector<uint64_t> words_;
+		uint64_t mask_;
+		size_t hashes_;
+		size_t inserted_ = 0;
+		size_t set_bits_ = 0;
+		double expected_omissions_ = 0.0;
+	public:
+		BitStateSet(size_t bytes, size_t hashes = 3);
+
+		bool Insert(uint64_t hash);
+		bool Contains(uint64_t hash) const;
+		void Clear();
+
+		size_t NumOfBits() const;
+		size_t NumOfHashes() const;
+		size_t NumOfInserted() const;
+		size_t NumOfSetBits() const;
+		size_t bytes() const;
+
+		double FillRatio() const;
+		double OmissionProbability() const;
+		double EstimatedStates() const;
+		double Coverage() const;
+	};
+
+}
\ No newline at end of file
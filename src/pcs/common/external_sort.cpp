@@ -0,0 +1,257 @@
+#include "pcs/common/external_sort.h"
+
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+#include "pcs/common/directory.h"
+
+namespace pcs {
+
+	// ==========================
+	// RecordWriter
+	// ==========================
+
+	RecordWriter::RecordWriter(const std::filesystem::path& path, size_t record_words, size_t buffer_bytes)
+		: record_words_(record_words), buffer_(std::max(record_words, buffer_bytes / sizeof(uint32_t) / record_words * record_words)) {
+		stream_.exceptions(std::ofstream::badbit | std::ofstream::failbit);
+		CreateDirectoryForPath(path);
+		stream_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	}
+
+	RecordWriter::~RecordWriter() {
+		try {
+			Close();
+		} catch (...) {}
+	}
+
+	void RecordWriter::Write(const uint32_t* record) {
+		if (buffered_ + record_words_ > buffer_.size()) {
+			Flush();
+		}
+		std::memcpy(buffer_.data() + buffered_, record, record_words_ * sizeof(uint32_t));
+		buffered_ += record_words_;
+		++count_;
+	}
+
+	void RecordWriter::Close() {
+		if (stream_.is_open()) {
+			Flush();
+			stream_.close();
+		}
+	}
+
+	size_t RecordWriter::count() const {
+		return count_;
+	}
+
+	void RecordWriter::Flush() {
+		stream_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffered_ * sizeof(uint32_t)));
+		buffered_ = 0;
+	}
+
+	// ==========================
+	// RecordReader
+	// ==========================
+
+	RecordReader::RecordReader(const std::filesystem::path& path, size_t record_words, size_t buffer_bytes)
+		: record_words_(record_words), buffer_(std::max(record_words, buffer_bytes / sizeof(uint32_t) / record_words * record_words)) {
+		stream_.exceptions(std::ifstream::badbit);
+		stream_.open(path, std::ios::in | std::ios::binary);
+		if (!stream_.is_open()) {
+			throw std::ifstream::failure("Unable to open " + path.string());
+		}
+		Fill();
+	}
+
+	bool RecordReader::Done() const {
+		return position_ >= available_;
+	}
+
+	const uint32_t* RecordReader::Current() const {
+		return buffer_.data() + position_;
+	}
+
+	void RecordReader::Advance() {
+		position_ += record_words_;
+		if (position_ >= available_) {
+			Fill();
+		}
+	}
+
+	void RecordReader::Fill() {
+		stream_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size() * sizeof(uint32_t)));
+		size_t words = static_cast<size_t>(stream_.gcount()) / sizeof(uint32_t);
+		available_ = words / record_words_ * record_words_;
+		position_ = 0;
+	}
+
+	// ==========================
+	// ExternalSorter
+	// ==========================
+
+	/**
+	 * @brief The buffer budget is split between the in-memory run (records plus a permutation index) and, when
+	 * merging, one stream buffer per input run, which bounds how many runs are merged per pass.
+	 */
+	ExternalSorter::ExternalSorter(const ExternalSortOpts& opts)
+		: opts_(opts) {
+		const size_t record_bytes = opts_.record_words * sizeof(uint32_t);
+		buffer_records_ = std::max<size_t>(1, opts_.buffer_bytes / (record_bytes + sizeof(uint32_t)));
+		stream_bytes_ = std::max(record_bytes, std::min<size_t>(1 << 16, opts_.buffer_bytes / 4));
+		fan_in_ = std::max<size_t>(2, opts_.buffer_bytes / stream_bytes_ - 1);
+		buffer_.reserve(std::min<size_t>(buffer_records_, 1 << 16) * opts_.record_words);
+	}
+
+	ExternalSorter::~ExternalSorter() {
+		std::error_code ec;
+		for (const auto& run : runs_) {
+			std::filesystem::remove(run, ec);
+		}
+	}
+
+	void ExternalSorter::Add(const uint32_t* record) {
+		if (buffer_.size() / opts_.record_words >= buffer_records_) {
+			Spill();
+		}
+		buffer_.insert(buffer_.end(), record, record + opts_.record_words);
+	}
+
+	/**
+	 * @brief Writes all added records to output in sorted order and removes the intermediate runs.
+	 * @returns The number of records written
+	 */
+	size_t ExternalSorter::Finish(const std::filesystem::path& output) {
+		if (runs_.empty()) {
+			return WriteSorted(output);
+		}
+		if (!buffer_.empty()) {
+			Spill();
+		}
+		while (runs_.size() > fan_in_) {
+			std::vector<std::filesystem::path> merged;
+			for (size_t i = 0; i < runs_.size(); i += fan_in_) {
+				std::vector<std::filesystem::path> group(runs_.begin() + i, runs_.begin() + std::min(i + fan_in_, runs_.size()));
+				if (group.size() == 1) {
+					merged.emplace_back(group.front());
+					continue;
+				}
+				std::filesystem::path run = RunPath();
+				Merge(group, run);
+				merged.emplace_back(run);
+			}
+			runs_ = std::move(merged);
+		}
+		size_t count = Merge(runs_, output);
+		runs_.clear();
+		return count;
+	}
+
+	/*
+	 * @brief Number of sorted runs spilled to disk so far, including intermediate merge results.
+	 */
+	size_t ExternalSorter::NumOfRuns() const {
+		return runs_written_;
+	}
+
+	bool ExternalSorter::Less(const uint32_t* a, const uint32_t* b) const {
+		const uint32_t* a_key = a + opts_.key_offset;
+		const uint32_t* b_key = b + opts_.key_offset;
+		auto [a_diff, b_diff] = std::mismatch(a_key, a_key + opts_.key_words, b_key);
+		if (a_diff != a_key + opts_.key_words) {
+			return *a_diff < *b_diff;
+		}
+		// Identical records must be adjacent for unique output, so break ties on the whole record
+		return opts_.unique && std::lexicographical_compare(a, a + opts_.record_words, b, b + opts_.record_words);
+	}
+
+	void ExternalSorter::Spill() {
+		std::filesystem::path run = RunPath();
+		WriteSorted(run);
+		runs_.emplace_back(run);
+	}
+
+	/*
+	 * @brief Sorts the in-memory buffer through a permutation and writes it out, then empties the buffer.
+	 */
+	size_t ExternalSorter::WriteSorted(const std::filesystem::path& output) {
+		const size_t words = opts_.record_words;
+		std::vector<uint32_t> order(buffer_.size() / words);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return Less(buffer_.data() + static_cast<size_t>(a) * words, buffer_.data() + static_cast<size_t>(b) * words);
+		});
+
+		RecordWriter writer(output, words, stream_bytes_);
+		const uint32_t* last = nullptr;
+		for (uint32_t i : order) {
+			const uint32_t* record = buffer_.data() + static_cast<size_t>(i) * words;
+			if (opts_.unique && last != nullptr && std::equal(record, record + words, last)) {
+				continue;
+			}
+			writer.Write(record);
+			last = record;
+		}
+		writer.Close();
+		buffer_.clear();
+		return writer.count();
+	}
+
+	/*
+	 * @brief K-way merge of sorted run files, each input is removed once consumed.
+	 */
+	size_t ExternalSorter::Merge(const std::vector<std::filesystem::path>& inputs, const std::filesystem::path& output) {
+		const size_t words = opts_.record_words;
+		std::vector<RecordReader> readers;
+		readers.reserve(inputs.size());
+		for (const auto& input : inputs) {
+			readers.emplace_back(input, words, stream_bytes_);
+		}
+		auto greater = [&](size_t a, size_t b) {
+			return Less(readers[b].Current(), readers[a].Current());
+		};
+		std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+		for (size_t i = 0; i < readers.size(); ++i) {
+			if (!readers[i].Done()) {
+				heap.push(i);
+			}
+		}
+
+		RecordWriter writer(output, words, stream_bytes_);
+		std::vector<uint32_t> last(words);
+		bool has_last = false;
+		while (!heap.empty()) {
+			size_t i = heap.top();
+			heap.pop();
+			const uint32_t* record = readers[i].Current();
+			if (!(opts_.unique && has_last && std::equal(record, record + words, last.begin()))) {
+				writer.Write(record);
+				std::copy(record, record + words, last.begin());
+				has_last = true;
+			}
+			readers[i].Advance();
+			if (!readers[i].Done()) {
+				heap.push(i);
+			}
+		}
+		writer.Close();
+		readers.clear();
+
+		std::error_code ec;
+		for (const auto& input : inputs) {
+			std::filesystem::remove(input, ec);
+		}
+		return writer.count();
+	}
+
+	std::filesystem::path ExternalSorter::RunPath() {
+		++runs_written_;
+		return opts_.directory / (opts_.name + "-" + std::to_string(runs_written_) + ".run");
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+namespace pcs {
+
+	/**
+	 * @brief Buffered sequential writer of fixed-width records of uint32_t words.
+	 * @exception Throws std::ofstream::failure on I/O errors
+	 */
+	class RecordWriter {
+	private:
+		std::ofstream stream_;
+		size_t record_words_;
+		std::vector<uint32_t> buffer_;
+		size_t buffered_ = 0;
+		size_t count_ = 0;
+	public:
+		RecordWriter(const std::filesystem::path& path, size_t record_words, size_t buffer_bytes = 1 << 16);
+		~RecordWriter();
+
+		void Write(const uint32_t* record);
+		void Close();
+		size_t count() const;
+	private:
+		void Flush();
+	};
+
+	/**
+	 * @brief Buffered sequential reader of a file written by RecordWriter.
+	 * @exception Throws std::ifstream::failure if the file cannot be opened
+	 */
+	class RecordReader {
+	private:
+		std::ifstream stream_;
+		size_t record_words_;
+		std::vector<uint32_t> buffer_;
+		size_t position_ = 0;
+		size_t available_ = 0;
+	public:
+		RecordReader(const std::filesystem::path& path, size_t record_words, size_t buffer_bytes = 1 << 16);
+
+		bool Done() const;
+		const uint32_t* Current() const;
+		void Advance();
+	private:
+		void Fill();
+	};
+
+	/**
+	 * @brief Options for ExternalSorter. Records are ordered lexicographically by the words
+	 * [key_offset, key_offset + key_words), and when unique is set identical records are written once.
+	 */
+	struct ExternalSortOpts {
+		size_t record_words;
+		size_t key_offset = 0;
+		size_t key_words;
+		bool unique = false;
+		size_t buffer_bytes = 64 * 1024 * 1024;
+		std::filesystem::path directory;
+		std::string name = "sort";
+	};
+
+	/**
+	 * @brief Sorts an unbounded stream of fixed-width records using at most roughly buffer_bytes of memory. Records
+	 * are collected in memory, sorted and spilled to run files in the scratch directory whenever the buffer is full,
+	 * and the runs are then merged (in several passes if there are more runs than can be merged at once).
+	 */
+	class ExternalSorter {
+	private:
+		ExternalSortOpts opts_;
+		size_t buffer_records_;
+		size_t stream_bytes_;
+		size_t fan_in_;
+		std::vector<uint32_t> buffer_;
+		std::vector<std::filesystem::path> runs_;
+		size_t runs_written_ = 0;
+	public:
+		ExternalSorter(const ExternalSortOpts& opts);
+		~ExternalSorter();
+
+		void Add(const uint32_t* record);
+		size_t Finish(const std::filesystem::path& output);
+		size_t NumOfRuns() const;
+
+		bool Less(const uint32_t* a, const uint32_t* b) const;
+	private:
+		void Spill();
+		size_t WriteSorted(const std::filesystem::path& output);
+		size_t Merge(const std::vector<std::filesystem::path>& inputs, const std::filesystem::path& output);
+		std::filesystem::path RunPath();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pcs {
+
+	inline constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+	inline constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+	/**
+	 * @brief 64-bit FNV-1a over a byte range, chainable through `seed`. Stable across platforms and runs, unlike std::hash.
+	 */
+	inline uint64_t Fnv1aBytes(const void* data, size_t size, uint64_t seed = kFnvOffsetBasis) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+
+	inline uint64_t Fnv1a(std::string_view str, uint64_t seed = kFnvOffsetBasis) {
+		// Hash the terminator too so that ("ab", "c") and ("a", "bc") differ when chained
+		return Fnv1aBytes("", 1, Fnv1aBytes(str.data(), str.size(), seed));
+	}
+
+	/**
+	 * @brief Finalisation step from SplitMix64, spreads FNV output across all bits before masking into a table.
+	 */
+	inline uint64_t Mix64(uint64_t x) {
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+
+	/**
+	 * @brief Hash of a global state key (one local state name per resource).
+	 */
+	inline uint64_t HashStrings(const std::vector<std::string>& strings, uint64_t seed = kFnvOffsetBasis) {
+		uint64_t hash = seed;
+		for (const auto& str : strings) {
+			hash = Fnv1a(str, hash);
+		}
+		return Mix64(hash);
+	}
+
+}
\ No newline at end of file
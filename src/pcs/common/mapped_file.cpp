@@ -0,0 +1,150 @@
+#include "pcs/common/mapped_file.h"
+
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace pcs {
+
+	// ==========================
+	// Constructors & destructor
+	// ==========================
+
+#ifdef _WIN32
+
+	MappedFile::MappedFile(const std::filesystem::path& path) {
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to open " + path.string());
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) {
+			CloseHandle(file);
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to stat " + path.string());
+		}
+		file_ = file;
+		size_ = static_cast<size_t>(size.QuadPart);
+		if (size_ == 0) {
+			return;
+		}
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			Close();
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to map " + path.string());
+		}
+		mapping_ = mapping;
+		data_ = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (data_ == nullptr) {
+			Close();
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to map " + path.string());
+		}
+	}
+
+	void MappedFile::Close() {
+		if (data_ != nullptr) {
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_ != nullptr) {
+			CloseHandle(mapping_);
+		}
+		if (file_ != nullptr) {
+			CloseHandle(file_);
+		}
+		data_ = nullptr;
+		mapping_ = nullptr;
+		file_ = nullptr;
+		size_ = 0;
+	}
+
+#else
+
+	MappedFile::MappedFile(const std::filesystem::path& path) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd == -1) {
+			throw std::system_error(errno, std::generic_category(), "Unable to open " + path.string());
+		}
+		struct stat st;
+		if (fstat(fd, &st) == -1) {
+			int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(), "Unable to stat " + path.string());
+		}
+		size_ = static_cast<size_t>(st.st_size);
+		if (size_ > 0) {
+			void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+			if (addr == MAP_FAILED) {
+				int error = errno;
+				close(fd);
+				size_ = 0;
+				throw std::system_error(error, std::generic_category(), "Unable to map " + path.string());
+			}
+			data_ = static_cast<const std::byte*>(addr);
+		}
+		// The mapping remains valid after the descriptor is closed
+		close(fd);
+	}
+
+	void MappedFile::Close() {
+		if (data_ != nullptr) {
+			munmap(const_cast<std::byte*>(data_), size_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+#endif
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+#ifdef _WIN32
+		, file_(std::exchange(other.file_, nullptr)), mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+	{}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			Close();
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+			file_ = std::exchange(other.file_, nullptr);
+			mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() {
+		Close();
+	}
+
+	// ==========================
+	// Member functions
+	// ==========================
+
+	const std::byte* MappedFile::data() const {
+		return data_;
+	}
+
+	size_t MappedFile::size() const {
+		return size_;
+	}
+
+	bool MappedFile::IsOpen() const {
+		return data_ != nullptr;
+	}
+
+}
\ No newline at end of file
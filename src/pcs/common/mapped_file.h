@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace pcs {
+
+	/**
+	 * @brief Read-only memory mapping of an entire file. The mapping is released on destruction.
+	 * @exception Constructor throws std::system_error if the file cannot be opened or mapped.
+	 */
+	class MappedFile {
+	private:
+		const std::byte* data_ = nullptr;
+		size_t size_ = 0;
+#ifdef _WIN32
+		void* file_ = nullptr;
+		void* mapping_ = nullptr;
+#endif
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& path);
+		MappedFile(const MappedFile& other) = delete;
+		MappedFile& operator=(const MappedFile& other) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		const std::byte* data() const;
+		size_t size() const;
+		bool IsOpen() const;
+	private:
+		void Close();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "pcs/common/shared_memory.h"
+
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace pcs {
+
+	// ==========================
+	// Constructors & destructor
+	// ==========================
+
+	SharedMemory::SharedMemory(SharedMemory&& other) noexcept
+		: data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)), writable_(other.writable_)
+#ifdef _WIN32
+		, mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+	{}
+
+	SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept {
+		if (this != &other) {
+			Close();
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			writable_ = other.writable_;
+#ifdef _WIN32
+			mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	SharedMemory::~SharedMemory() {
+		Close();
+	}
+
+	// ==========================
+	// Platform specific
+	// ==========================
+
+#ifdef _WIN32
+
+	std::string SharedMemory::SystemName(const std::string& name) {
+		return "Local\\" + name;
+	}
+
+	/*
+	 * @brief Creates a new segment of the given size, mapped for writing. A name stays in use on Windows until every
+	 * handle to it is closed, and the existing mapping would keep its old size, so a live name is never reused.
+	 */
+	SharedMemory SharedMemory::Create(const std::string& name, size_t size) {
+		SharedMemory shm;
+		uint64_t size64 = size;
+		HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+			static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xffffffff), SystemName(name).c_str());
+		if (mapping == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to create shared memory " + name);
+		}
+		if (GetLastError() == ERROR_ALREADY_EXISTS) {
+			CloseHandle(mapping);
+			throw std::system_error(ERROR_ALREADY_EXISTS, std::system_category(), "Shared memory " + name + " is still in use");
+		}
+		shm.mapping_ = mapping;
+		shm.data_ = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size));
+		if (shm.data_ == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to map shared memory " + name);
+		}
+		shm.size_ = size;
+		shm.writable_ = true;
+		return shm;
+	}
+
+	/*
+	 * @brief Attaches to an existing segment read-only.
+	 */
+	SharedMemory SharedMemory::Open(const std::string& name) {
+		SharedMemory shm;
+		HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, SystemName(name).c_str());
+		if (mapping == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to open shared memory " + name);
+		}
+		shm.mapping_ = mapping;
+		shm.data_ = static_cast<std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (shm.data_ == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Unable to map shared memory " + name);
+		}
+		MEMORY_BASIC_INFORMATION info;
+		VirtualQuery(shm.data_, &info, sizeof(info));
+		shm.size_ = info.RegionSize;
+		return shm;
+	}
+
+	/*
+	 * @brief Named mappings are released with their last handle on Windows, so this only reports whether the name
+	 * is free, i.e. whether no process still holds the segment open.
+	 */
+	bool SharedMemory::Remove(const std::string& name) {
+		HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, SystemName(name).c_str());
+		if (mapping == nullptr) {
+			return true;
+		}
+		CloseHandle(mapping);
+		return false;
+	}
+
+	void SharedMemory::Close() {
+		if (data_ != nullptr) {
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_ != nullptr) {
+			CloseHandle(mapping_);
+		}
+		data_ = nullptr;
+		mapping_ = nullptr;
+		size_ = 0;
+	}
+
+#else
+
+	std::string SharedMemory::SystemName(const std::string& name) {
+		return (!name.empty() && name.front() == '/') ? name : '/' + name;
+	}
+
+	/*
+	 * @brief Creates a new segment of the given size, mapped for writing. An existing segment of the same name is
+	 * unlinked rather than truncated, so processes attached to it keep reading the old contents.
+	 */
+	SharedMemory SharedMemory::Create(const std::string& name, size_t size) {
+		SharedMemory shm;
+		shm_unlink(SystemName(name).c_str());
+		int fd = shm_open(SystemName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (fd == -1) {
+			throw std::system_error(errno, std::generic_category(), "Unable to create shared memory " + name);
+		}
+		if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+			int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(), "Unable to size shared memory " + name);
+		}
+		if (size > 0) {
+			void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (addr == MAP_FAILED) {
+				int error = errno;
+				close(fd);
+				throw std::system_error(error, std::generic_category(), "Unable to map shared memory " + name);
+			}
+			shm.data_ = static_cast<std::byte*>(addr);
+		}
+		close(fd);
+		shm.size_ = size;
+		shm.writable_ = true;
+		return shm;
+	}
+
+	/*
+	 * @brief Attaches to an existing segment read-only.
+	 */
+	SharedMemory SharedMemory::Open(const std::string& name) {
+		SharedMemory shm;
+		int fd = shm_open(SystemName(name).c_str(), O_RDONLY, 0);
+		if (fd == -1) {
+			throw std::system_error(errno, std::generic_category(), "Unable to open shared memory " + name);
+		}
+		struct stat st;
+		if (fstat(fd, &st) == -1) {
+			int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(), "Unable to stat shared memory " + name);
+		}
+		shm.size_ = static_cast<size_t>(st.st_size);
+		if (shm.size_ > 0) {
+			void* addr = mmap(nullptr, shm.size_, PROT_READ, MAP_SHARED, fd, 0);
+			if (addr == MAP_FAILED) {
+				int error = errno;
+				close(fd);
+				shm.size_ = 0;
+				throw std::system_error(error, std::generic_category(), "Unable to map shared memory " + name);
+			}
+			shm.data_ = static_cast<std::byte*>(addr);
+		}
+		close(fd);
+		return shm;
+	}
+
+	/*
+	 * @brief Unlinks the segment name. Processes which are already attached keep their mapping.
+	 */
+	bool SharedMemory::Remove(const std::string& name) {
+		return shm_unlink(SystemName(name).c_str()) == 0;
+	}
+
+	void SharedMemory::Close() {
+		if (data_ != nullptr) {
+			munmap(data_, size_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+#endif
+
+	// ==========================
+	// Member functions
+	// ==========================
+
+	const std::byte* SharedMemory::data() const {
+		return data_;
+	}
+
+	/*
+	 * @exception Throws std::logic_error for segments which were attached read-only
+	 */
+	std::byte* SharedMemory::mutable_data() {
+		if (!writable_) {
+			throw std::logic_error("Shared memory was opened read-only");
+		}
+		return data_;
+	}
+
+	size_t SharedMemory::size() const {
+		return size_;
+	}
+
+	bool SharedMemory::IsOpen() const {
+		return data_ != nullptr;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace pcs {
+
+	/**
+	 * @brief A named shared memory segment (POSIX shm_open / Win32 named file mapping), unmapped on destruction.
+	 *
+	 * POSIX segments persist until Remove() is called, whereas Windows releases a segment once the last handle to it
+	 * is closed, so the creating process should keep its SharedMemory alive whilst others are attached. Creating a
+	 * segment never modifies one that others are attached to: on POSIX the old name is unlinked first, on Windows
+	 * Create() fails whilst the name is still in use.
+	 * @exception Create() and Open() throw std::system_error on failure
+	 */
+	class SharedMemory {
+	private:
+		std::byte* data_ = nullptr;
+		size_t size_ = 0;
+		bool writable_ = false;
+#ifdef _WIN32
+		void* mapping_ = nullptr;
+#endif
+	public:
+		SharedMemory() = default;
+		SharedMemory(const SharedMemory& other) = delete;
+		SharedMemory& operator=(const SharedMemory& other) = delete;
+		SharedMemory(SharedMemory&& other) noexcept;
+		SharedMemory& operator=(SharedMemory&& other) noexcept;
+		~SharedMemory();
+
+		static SharedMemory Create(const std::string& name, size_t size);
+		static SharedMemory Open(const std::string& name);
+		static bool Remove(const std::string& name);
+
+		const std::byte* data() const;
+		std::byte* mutable_data();
+		size_t size() const;
+		bool IsOpen() const;
+	private:
+		static std::string SystemName(const std::string& name);
+		void Close();
+	};
+
+}
\ No newline at end of file
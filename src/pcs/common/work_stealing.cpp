@@ -0,0 +1,166 @@
+#include "pcs/common/work_stealing.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+namespace pcs {
+
+	// The pool and worker index of the calling thread, so that Spawn() from within a task targets its own deque
+	static thread_local const WorkStealingPool* current_pool = nullptr;
+	static thread_local size_t current_worker = 0;
+
+	/*
+	 * @param threads: number of workers including the thread calling Run(), zero for the hardware concurrency
+	 */
+	WorkStealingPool::WorkStealingPool(size_t threads) {
+		if (threads == 0) {
+			threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+		for (size_t i = 0; i < threads; ++i) {
+			queues_.emplace_back(std::make_unique<Queue>());
+		}
+		for (size_t i = 1; i < threads; ++i) {
+			threads_.emplace_back([this, i]() { Work(i); });
+		}
+	}
+
+	WorkStealingPool::~WorkStealingPool() {
+		{
+			std::scoped_lock lock(idle_mutex_);
+			stop_ = true;
+		}
+		idle_.notify_all();
+	}
+
+	/**
+	 * @brief Runs the root task and everything it spawns, returning once all tasks have completed. The calling thread
+	 * acts as worker 0, and sleeps rather than spins whilst the other workers finish.
+	 * @exception Rethrows the first exception thrown by a task, after the remaining tasks have run. Throws
+	 *            std::logic_error when called from within one of the pool's own tasks.
+	 */
+	void WorkStealingPool::Run(Task root) {
+		if (current_pool == this) {
+			throw std::logic_error("[Work Stealing] A task cannot Run() its own pool");
+		}
+		error_ = nullptr;
+		const WorkStealingPool* previous_pool = current_pool;
+		size_t previous_worker = current_worker;
+		current_pool = this;
+		current_worker = 0;
+		Spawn(std::move(root));
+		while (true) {
+			Drain(0);
+			std::unique_lock lock(idle_mutex_);
+			idle_.wait(lock, [this]() { return pending_ == 0 || queued_ > 0; });
+			if (pending_ == 0) {
+				break;
+			}
+		}
+		current_pool = previous_pool;
+		current_worker = previous_worker;
+		if (error_) {
+			std::rethrow_exception(error_);
+		}
+	}
+
+	/**
+	 * @brief Adds a task, to the calling worker's deque from within a task and to worker 0's otherwise, waking an idle
+	 * worker to take it.
+	 */
+	void WorkStealingPool::Spawn(Task task) {
+		size_t worker = (current_pool == this) ? current_worker : 0;
+		++pending_;
+		{
+			std::scoped_lock lock(idle_mutex_);
+			++queued_;
+		}
+		{
+			std::scoped_lock lock(queues_[worker]->mutex);
+			queues_[worker]->tasks.emplace_back(std::move(task));
+		}
+		idle_.notify_one();
+	}
+
+	size_t WorkStealingPool::size() const {
+		return queues_.size();
+	}
+
+	/**
+	 * @brief The number of tasks taken from another worker's deque, over all runs
+	 */
+	size_t WorkStealingPool::NumOfSteals() const {
+		return steals_;
+	}
+
+	/*
+	 * @brief The loop of a worker thread: sleeps until tasks are queued, then runs tasks until none are left to take.
+	 */
+	void WorkStealingPool::Work(size_t worker) {
+		current_pool = this;
+		current_worker = worker;
+		while (true) {
+			{
+				std::unique_lock lock(idle_mutex_);
+				idle_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+				if (stop_) {
+					return;
+				}
+			}
+			Drain(worker);
+		}
+	}
+
+	/*
+	 * @brief Runs tasks from the worker's own deque, then stolen ones, until there are none left to take.
+	 */
+	void WorkStealingPool::Drain(size_t worker) {
+		Task task;
+		while (Pop(worker, task) || Steal(worker, task)) {
+			try {
+				task(worker);
+			} catch (...) {
+				std::scoped_lock lock(error_mutex_);
+				if (!error_) {
+					error_ = std::current_exception();
+				}
+			}
+			task = nullptr;
+			if (--pending_ == 0) {
+				{
+					std::scoped_lock lock(idle_mutex_); // Order the wake-up after Run() checks pending_
+				}
+				idle_.notify_all();
+			}
+		}
+	}
+
+	bool WorkStealingPool::Pop(size_t worker, Task& task) {
+		Queue& queue = *queues_[worker];
+		std::scoped_lock lock(queue.mutex);
+		if (queue.tasks.empty()) {
+			return false;
+		}
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		--queued_;
+		return true;
+	}
+
+	bool WorkStealingPool::Steal(size_t worker, Task& task) {
+		for (size_t i = 1; i < queues_.size(); ++i) {
+			Queue& victim = *queues_[(worker + i) % queues_.size()];
+			std::scoped_lock lock(victim.mutex);
+			if (!victim.tasks.empty()) {
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				--queued_;
+				++steals_;
+				return true;
+			}
+		}
+		return false;
+	}
+
+}
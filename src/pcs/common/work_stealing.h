@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <exception>
+
+namespace pcs {
+
+	/**
+	 * @brief Fork-join pool of worker threads, each with its own deque of tasks. A worker pushes the tasks it spawns
+	 * onto the back of its own deque and pops from the back, so it continues depth first where it left off, whilst idle
+	 * workers steal the oldest task from the front of another deque, which tends to be the largest piece of work left.
+	 * Tasks receive the index of the worker running them, so callers can keep per-worker state without locking.
+	 * The worker threads are started once and sleep whilst there is nothing to run, so a pool can be kept and Run()
+	 * many times. Tasks may Run() other pools, but not their own.
+	 */
+	class WorkStealingPool {
+	public:
+		using Task = std::function<void(size_t worker)>;
+	private:
+		struct Queue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Queue>> queues_;
+		std::atomic<size_t> pending_ = 0;
+		std::atomic<size_t> queued_ = 0;
+		std::atomic<size_t> steals_ = 0;
+		std::mutex idle_mutex_;
+		std::condition_variable idle_;
+		bool stop_ = false;
+		std::mutex error_mutex_;
+		std::exception_ptr error_;
+		std::vector<std::jthread> threads_;
+	public:
+		explicit WorkStealingPool(size_t threads);
+		WorkStealingPool(const WorkStealingPool& other) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool& other) = delete;
+		~WorkStealingPool();
+
+		void Run(Task root);
+		void Spawn(Task task);
+
+		size_t size() const;
+		size_t NumOfSteals() const;
+	private:
+		void Work(size_t worker);
+		void Drain(size_t worker);
+		bool Pop(size_t worker, Task& task);
+		bool Steal(size_t worker, Task& task);
+	};
+
+}
@@ -5,14 +5,26 @@
 #include <string>
 #include <algorithm>
 #include <unordered_map>
+#include <queue>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <bit>
+#include <stdexcept>
+#include <utility>
 
 #include <spdlog/fmt/bundled/color.h>
 #include <spdlog/fmt/ranges.h>
 
 #include "pcs/lts/lts.h"
 #include "pcs/common/log.h"
+#include "pcs/common/hash.h"
 #include "pcs/common/strings.h"
+#include "pcs/common/work_stealing.h"
 #include "pcs/operation/parsers/label.h"
+#include "pcs/topology/core.h"
 
 namespace pcs {
 
@@ -22,18 +34,52 @@ namespace pcs {
 	using ControllerTransition = std::vector<std::string>;
 	using ControllerState = std::vector<std::string>;
 
-	Controller::Controller(const Environment* machine, ITopology* topology, const Recipe* recipe)
-		: machine_(machine), recipe_(recipe), topology_(topology), num_of_resources_(machine_->NumOfResources()) {}
+	static constexpr size_t kUnreachable = SIZE_MAX;
+
+	/*
+	 * @brief Runs the callable when leaving the scope, whether by return or by exception
+	 */
+	template <typename F>
+	class ScopeExit {
+	private:
+		F f_;
+	public:
+		explicit ScopeExit(F f) : f_(std::move(f)) {}
+		ScopeExit(const ScopeExit& other) = delete;
+		ScopeExit& operator=(const ScopeExit& other) = delete;
+		~ScopeExit() {
+			f_();
+		}
+	};
+
+	Controller::Controller(const Environment* machine, ITopology* topology, const Recipe* recipe, const ControllerOpts& opts)
+		: machine_(machine), recipe_(recipe), topology_(topology), part_names_(std::make_shared<PartNames>(recipe->part_names())),
+		  num_of_resources_(machine_->NumOfResources()), opts_(opts) {
+		guards_ = CompileGuards(*recipe_, *part_names_, num_of_resources_);
+	}
 
 	std::optional<const LTS<std::vector<std::string>, std::vector<std::string>, boost::hash<std::vector<std::string>>>*> Controller::Generate() {
 		const std::string& recipe_state = recipe_->lts().initial_state();
 		controller_.set_initial_state(topology_->initial_state(), true);
-		Parts plan_parts(machine_->NumOfResources());
+		Parts plan_parts(machine_->NumOfResources(), part_names_);
+		frames_.clear();
+		transpositions_.Clear();
+		expansions_ = 0;
+		pruned_transfers_ = 0;
+		disabled_ = 0;
+		plan_cost_ = 0.0;
+		if (visited_.has_value()) {
+			visited_->Clear();
+		}
 
 		PCS_INFO(fmt::format(fmt::fg(fmt::color::light_green), "Controller initial state {}", fmt::join(controller_.initial_state(), ",")));
 		PCS_INFO(fmt::format(fmt::fg(fmt::color::light_green), "Recipe initial state: {}", recipe_state));
+		if (opts_.precheck && !Precheck(*recipe_).passed()) {
+			return {};
+		}
 
-		bool generated = ProcessRecipe(recipe_state, &controller_.initial_state(), plan_parts);
+		bool generated = (opts_.threads == 1) ? ProcessRecipe(recipe_state, &controller_.initial_state(), plan_parts)
+			: ProcessRecipeParallel(recipe_state, &controller_.initial_state(), plan_parts);
 		PCS_INFO(fmt::format(fmt::fg(fmt::color::light_green), "Controller generation completed: realisability = {}", generated));
 
 		/* ******************************************************************************************* /
@@ -50,75 +96,877 @@ namespace pcs {
 	}
 
 	/**
-	 * @brief Recursively process all recipe states, accounting for transitions due to guards.
+	 * @brief Decides whether the recipe is realisable without building a controller, stopping at the first recipe
+	 * transition which is not. Unlike Generate(), every recipe transition reached must be realisable, and the
+	 * transposition table is kept from earlier calls, so repeated decisions reuse the memoised searches. The recipe
+	 * is processed on the calling thread whatever ControllerOpts::threads.
+	 */
+	Realisability Controller::Decide() {
+		return Decide(*recipe_);
+	}
+
+	/**
+	 * @brief Decide() for another recipe over the same environment and topology, such as a variant of the controller's
+	 * own recipe. Memoised searches depend on the topology state and operation only, so they carry over.
+	 */
+	Realisability Controller::Decide(const Recipe& recipe) {
+		const Recipe* own = recipe_;
+		std::optional<CompiledGuards> own_guards;
+		// Restore the controller's own recipe and guards however the decision ends, so Generate() still works after a throw
+		ScopeExit restore([&]() {
+			if (own_guards.has_value()) {
+				guards_ = std::move(*own_guards);
+			}
+			decide_ = false;
+			recipe_ = own;
+		});
+		recipe_ = &recipe;
+		decide_ = true;
+		expansions_ = 0;
+		disabled_ = 0;
+		if (visited_.has_value()) {
+			visited_->Clear();
+		}
+		Realisability result;
+		if (opts_.precheck) {
+			if (PrecheckResult precheck = Precheck(recipe); !precheck.passed()) {
+				return { .realisable = false, .from = std::move(precheck.from), .to = std::move(precheck.to),
+					.transition = precheck.transition, .operation = std::move(precheck.operation), .precheck = precheck.failure };
+			}
+		}
+		// Intern the variant's parts into the controller's names, so that its guards and inventory share their ids
+		for (const auto& name : recipe.part_names().names()) {
+			part_names_->Intern(name);
+		}
+		if (&recipe != own) {
+			CompiledGuards guards = CompileGuards(recipe, *part_names_, num_of_resources_);
+			own_guards.emplace(std::exchange(guards_, std::move(guards)));
+		}
+		Parts plan_parts(num_of_resources_, part_names_);
+		result.realisable = DecideRecipe(recipe_->lts().initial_state(), &topology_->initial_state(), plan_parts, result);
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::light_green), "Controller decision completed: realisability = {}", result.realisable));
+		return result;
+	}
+
+	/**
+	 * @brief Enables a bitstate visited set of fixed size for the transfer searches, so that states already explored
+	 * by the search for the current operation are not expanded again. Each search salts the state hashes rather than
+	 * clearing the bits, so the set fills up over a Generate() or Decide(); check bitstate()->Coverage() afterwards.
+	 * A false positive can make a search miss a realisable operation, so failed searches are not memoised.
+	 */
+	void Controller::set_bitstate(size_t bytes, size_t hashes) {
+		visited_.emplace(bytes, hashes);
+	}
+
+	const BitStateSet* Controller::bitstate() const {
+		return visited_.has_value() ? &*visited_ : nullptr;
+	}
+
+	/**
+	 * @brief Uses the index to skip transfers into states from which the operation cannot be reached, and as the exact
+	 * A* heuristic. The index may be one kept up to date by an IncrementalTopology; states it has not been given yet,
+	 * or whose distances may still drop as more states are expanded, are neither pruned nor estimated by it.
 	 */
-	bool Controller::ProcessRecipe(const std::string& recipe_state, const std::vector<std::string>* topology_state, const Parts plan_parts) {
+	void Controller::set_reachability_index(const ReachabilityIndex* index) {
+		reachability_ = index;
+	}
+
+	/**
+	 * @brief The memoised operation searches of the last Generate(), along with their hit and miss counts.
+	 */
+	const TranspositionTable& Controller::transpositions() const {
+		return transpositions_;
+	}
+
+	/**
+	 * @brief The number of topology states expanded by the searches of the last Generate().
+	 */
+	size_t Controller::NumOfExpansions() const {
+		return expansions_;
+	}
+
+	/**
+	 * @brief The number of transfers skipped by ControllerOpts::prune_transfers and the reachability index during the
+	 * last Generate()
+	 */
+	size_t Controller::NumOfPrunedTransfers() const {
+		return pruned_transfers_;
+	}
+
+	/**
+	 * @brief The number of recipe transitions skipped during the last Generate() or Decide() as their guard did not hold
+	 */
+	size_t Controller::NumOfDisabledTransitions() const {
+		return disabled_;
+	}
+
+	/**
+	 * @brief The cost of the transitions added to the controller by the last Generate(), under ControllerOpts::objective.
+	 * Unannotated resource transitions cost TransitionCosts::kDefaultCost.
+	 */
+	double Controller::PlanCost() const {
+		return plan_cost_;
+	}
+
+	/**
+	 * @brief Recursively process all recipe states, accounting for transitions due to guards. Each recipe branch
+	 * starts from the parts at this recipe state, changes made by a branch are rolled back before the next. Branches
+	 * whose guard does not hold are skipped before any search.
+	 */
+	bool Controller::ProcessRecipe(const std::string& recipe_state, const std::vector<std::string>* topology_state, Parts& plan_parts) {
 		for (const auto& pair : recipe_->lts()[recipe_state].transitions_) {
 			const CompositeOperation& co = pair.label();
+			if (!IsEnabled(co, *topology_state, plan_parts)) {
+				continue;
+			}
 			PCS_INFO(fmt::format(fmt::fg(fmt::color::gold) | fmt::emphasis::bold, "Processing recipe transition to: {}",
 				recipe_->lts()[recipe_state].transitions_[0].to()));
 
+			size_t checkpoint = plan_parts.Checkpoint();
 			auto c_op = HandleComposite(co, *topology_state, plan_parts);
 			if (!c_op.has_value()) {
+				plan_parts.Rollback(checkpoint);
 				return {};
 			}
-			ProcessRecipe(pair.to(), c_op.value().first, c_op.value().second);
+			ProcessRecipe(pair.to(), c_op.value(), plan_parts);
+			plan_parts.Rollback(checkpoint);
+		}
+		return true;
+	}
+
+
+	/*
+	 * @brief Whether the guard of the recipe transition holds, counting the transitions it disables
+	 */
+	bool Controller::IsEnabled(const CompositeOperation& co, const TopologyState& topology_state, const Parts& plan_parts) {
+		auto it = guards_.find(&co);
+		if (it == guards_.end() || it->second.Holds(plan_parts, topology_state)) {
+			return true;
+		}
+		++disabled_;
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::gold), "Guard {} ({}) disables the recipe transition", co.guard.first.name(),
+			ToString(it->second.kind())));
+		return false;
+	}
+
+	/*
+	 * @brief Runs the Prechecker, which summarises the environment on first use
+	 */
+	PrecheckResult Controller::Precheck(const Recipe& recipe) {
+		if (!prechecker_.has_value()) {
+			prechecker_.emplace(*machine_);
+		}
+		return prechecker_->Check(recipe);
+	}
+
+	/*
+	 * @brief ProcessRecipe without recording transitions, which fails as soon as any enabled recipe transition does
+	 */
+	bool Controller::DecideRecipe(const std::string& recipe_state, const TopologyState* topology_state, Parts& plan_parts,
+		Realisability& result) {
+		const auto& transitions = recipe_->lts()[recipe_state].transitions_;
+		for (size_t i = 0; i < transitions.size(); ++i) {
+			if (!IsEnabled(transitions[i].label(), *topology_state, plan_parts)) {
+				continue;
+			}
+			size_t checkpoint = plan_parts.Checkpoint();
+			failed_operation_.clear();
+			auto c_op = HandleComposite(transitions[i].label(), *topology_state, plan_parts);
+			if (!c_op.has_value()) {
+				result.from = recipe_state;
+				result.to = transitions[i].to();
+				result.transition = i;
+				result.operation = failed_operation_;
+				return false;
+			}
+			if (!DecideRecipe(transitions[i].to(), c_op.value(), plan_parts, result)) {
+				return false;
+			}
+			plan_parts.Rollback(checkpoint);
 		}
+		return true;
 	}
 
+	/**
+	 * @brief ProcessRecipe over a work stealing pool. Every recipe transition is a task, handled by the worker's own
+	 * controller given the topology state and parts it starts from, which spawns a task for each transition following it.
+	 * The fragments are then added in the order ProcessRecipe would add them, leaving out those it would not have reached
+	 * because an earlier sibling failed, so the controller is the same as the sequential one. Branches are explored
+	 * speculatively, workers keep their own transposition tables and do not use the bitstate set, and topology lookups
+	 * are serialised as most topologies materialise states on demand.
+	 */
+	bool Controller::ProcessRecipeParallel(const std::string& recipe_state, const TopologyState* topology_state, const Parts& plan_parts) {
+		WorkStealingPool pool(opts_.threads);
+		std::mutex topology_mutex;
+		ControllerOpts worker_opts = opts_;
+		worker_opts.threads = 1;
+		// Share the speculative search threads out between the workers, rather than giving each worker as many
+		size_t search_threads = (opts_.search_threads == 0) ? std::max<size_t>(1, std::thread::hardware_concurrency()) : opts_.search_threads;
+		worker_opts.search_threads = std::max<size_t>(1, search_threads / pool.size());
+		std::vector<std::unique_ptr<Controller>> workers;
+		for (size_t i = 0; i < pool.size(); ++i) {
+			workers.emplace_back(std::make_unique<Controller>(machine_, topology_, recipe_, worker_opts));
+			workers.back()->topology_mutex_ = &topology_mutex;
+			workers.back()->reachability_ = reachability_;
+		}
+
+		std::mutex fragments_mutex;
+		std::vector<BranchFragment> fragments;
+		std::function<void(size_t, const std::string&, const TopologyState*, const Parts&, const BranchFragment&)> spawn_branches;
+		spawn_branches = [&](size_t worker, const std::string& state, const TopologyState* from, const Parts& parts, const BranchFragment& parent) {
+			const auto& transitions = recipe_->lts()[state].transitions_;
+			for (size_t i = 0; i < transitions.size(); ++i) {
+				if (!workers[worker]->IsEnabled(transitions[i].label(), *from, parts)) {
+					continue;
+				}
+				BranchFragment fragment{ .path = parent.path, .plan = parent.plan, .base = parent.plan.size() };
+				fragment.path.emplace_back(i);
+				pool.Spawn([&, t = &transitions[i], from, parts = parts.Fork(), fragment = std::move(fragment)](size_t worker) mutable {
+					Controller& controller = *workers[worker];
+					PCS_INFO(fmt::format(fmt::fg(fmt::color::gold) | fmt::emphasis::bold, "Processing recipe transition to: {} on worker {}",
+						t->to(), worker));
+					controller.fragment_ = &fragment.plan;
+					auto end = controller.HandleComposite(t->label(), *from, parts);
+					controller.fragment_ = nullptr;
+					fragment.realised = end.has_value();
+					if (fragment.realised) {
+						spawn_branches(worker, t->to(), *end, parts, fragment);
+					}
+					std::scoped_lock lock(fragments_mutex);
+					fragments.emplace_back(std::move(fragment));
+				});
+			}
+		};
+		pool.Run([&](size_t worker) { spawn_branches(worker, recipe_state, topology_state, plan_parts, {}); });
+
+		// Preorder over the recipe transitions taken, and the first failing transition out of each recipe state reached
+		std::sort(fragments.begin(), fragments.end(), [](const BranchFragment& a, const BranchFragment& b) { return a.path < b.path; });
+		std::map<std::vector<size_t>, size_t> first_failure;
+		for (const auto& fragment : fragments) {
+			if (!fragment.realised) {
+				std::vector<size_t> parent(fragment.path.begin(), fragment.path.end() - 1);
+				first_failure.try_emplace(std::move(parent), fragment.path.back());
+			}
+		}
+		for (const auto& fragment : fragments) {
+			bool reached = true;
+			for (size_t depth = 0; depth < fragment.path.size() && reached; ++depth) {
+				auto it = first_failure.find(std::vector<size_t>(fragment.path.begin(), fragment.path.begin() + depth));
+				reached = (it == first_failure.end() || fragment.path[depth] <= it->second);
+			}
+			if (!reached) {
+				continue;
+			}
+			fragment.plan.ForEach([this](const PlanTransition& plan_t) { ApplyTransition(plan_t); }, fragment.plan.size() - fragment.base);
+		}
+		for (const auto& worker : workers) {
+			expansions_ += worker->expansions_;
+			pruned_transfers_ += worker->pruned_transfers_;
+			disabled_ += worker->disabled_;
+		}
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::light_green), "Explored {} recipe transitions on {} workers with {} steals",
+			fragments.size(), pool.size(), pool.NumOfSteals()));
+		return !first_failure.contains({});
+	}
 
 	/**
-	 * @brief Handles a Composite Operation type, the Transition type present within Recipe States/LTS
+	 * @brief Handles a Composite Operation type, the Transition type present within Recipe States/LTS: its sequential
+	 * operations one after another, then its parallel operations together, see SearchParallel().
 	 */
-	std::optional<std::pair<const TopologyState*, Parts>> Controller::HandleComposite(const CompositeOperation& co, const TopologyState& topology_state,
-		Parts plan_parts) {
+	std::optional<const Controller::TopologyState*> Controller::HandleComposite(const CompositeOperation& co, const TopologyState& topology_state,
+		Parts& plan_parts) {
 		const std::vector<std::string>* res_state = &topology_state;
-		for (const auto& tuple : co.sequential) {
-			const auto& [op, input, output] = tuple;
-			PCS_INFO(fmt::format(fmt::fg(fmt::color::lavender), "Handling operation: \"{}\" with input parts [{}] and output parts [{}]",
-				op.name(), fmt::join(input, ","), fmt::join(output, ",")));
-
-			std::vector<PlanTransition> plan_transitions;
-			auto seq = HandleSequentialOperation(*res_state, plan_transitions, plan_parts, tuple);
-			if (!seq.has_value()) {
+		if (opts_.search == SearchMode::kCheapest) {
+			auto end = SearchCheapest(co, topology_state);
+			if (!end.has_value()) {
 				return {};
 			}
-			res_state = seq.value().first;
-			plan_parts = seq.value().second;
+			for (const auto& plan_t : plan_) {
+				ApplyTransition(plan_t);
+			}
+			for (size_t i = 0; i < realised_.size(); ++i) {
+				plan_parts.Consume(realised_[i]->label().first, std::get<1>(co.sequential[i]));
+				plan_parts.Add(realised_[i]->label(), std::get<2>(co.sequential[i]));
+			}
+			res_state = end.value();
+		} else {
+			for (const auto& tuple : co.sequential) {
+				const auto& [op, input, output] = tuple;
+				PCS_INFO(fmt::format(fmt::fg(fmt::color::lavender), "Handling operation: \"{}\" with input parts [{}] and output parts [{}]",
+					op.name(), fmt::join(input, ","), fmt::join(output, ",")));
+
+				if (visited_.has_value()) {
+					++search_;
+					visited_->Insert(HashStrings(*res_state, kFnvOffsetBasis ^ Mix64(search_)));
+				}
+				auto seq = HandleSequentialOperation(*res_state, plan_parts, tuple);
+				if (!seq.has_value()) {
+					failed_operation_ = op.name();
+					return {};
+				}
+				res_state = seq.value();
+			}
+		}
+		if (!co.parallel.empty()) {
+			return HandleParallel(co, *res_state, plan_parts);
 		}
-		return { std::make_pair(res_state, plan_parts) };
+		return res_state;
 	}
 
 	/**
-	 * @brief Handles a single sequential operation. Returns the resulting end-state if reliasable, nullopt otherwise.
+	 * @brief Handles a single sequential operation. Returns the resulting end-state if realisable, nullopt otherwise.
+	 * The resource performing the operation consumes its input parts and receives its output parts. With memoisation,
+	 * the outcome is recorded against the start state and operation, and a repeated search replays the recorded plan
+	 * instead, applying the parts to the inventory it is replayed with.
 	 */
-	std::optional<std::pair<const TopologyState*, Parts>> Controller::HandleSequentialOperation(const TopologyState& topology_state,
-		                                                             std::vector<PlanTransition> plan_transitions,
-		                                                             Parts plan_parts, 
-		                                                             const std::tuple<Observable, std::vector<std::string>, std::vector<std::string>>& seq_tuple ) {
+	std::optional<const Controller::TopologyState*> Controller::HandleSequentialOperation(const TopologyState& topology_state, Parts& plan_parts,
+		const std::tuple<Observable, std::vector<std::string>, std::vector<std::string>>& seq_tuple) {
 		const auto& [op, input, output] = seq_tuple;
+		std::optional<TranspositionKey> key;
+		if (opts_.memoise) {
+			key.emplace(topology_state, op.name());
+			if (const TranspositionEntry* entry = transpositions_.Find(*key); entry != nullptr) {
+				if (!entry->IsRealisable()) {
+					return {};
+				}
+				entry->plan.ForEach([this](const PlanTransition& plan_t) { ApplyTransition(plan_t); });
+				plan_parts.Consume(entry->realised.first, input);
+				plan_parts.Add(entry->realised, output);
+				return entry->end;
+			}
+		}
+
+		if (opts_.prune_transfers) {
+			const std::vector<bool>& relevant = RelevantComponents(op.name());
+			if (std::find(relevant.begin(), relevant.end(), true) == relevant.end()) {
+				if (key.has_value()) {
+					transpositions_.Insert(std::move(*key), {});
+				}
+				return {}; // No resource offers the operation at all
+			}
+		}
+		if (reachability_ != nullptr) {
+			auto id = reachability_->Find(topology_state);
+			if (id.has_value() && reachability_->Distance(*id, op.name()) == ReachabilityIndex::kUnreachable) {
+				if (key.has_value()) {
+					transpositions_.Insert(std::move(*key), {});
+				}
+				return {};
+			}
+		}
+		const TopologyEdge* realised = nullptr;
+		if (opts_.search == SearchMode::kDepthFirst) {
+			realised = SearchTransfers(topology_state, op);
+		} else if (opts_.search == SearchMode::kSpeculative) {
+			realised = SearchSpeculative(topology_state, op);
+		} else {
+			realised = SearchShortest(topology_state, op);
+		}
+		if (realised == nullptr) {
+			if (key.has_value() && !visited_.has_value()) { // A bitstate search may have skipped the way to the operation
+				transpositions_.Insert(std::move(*key), {});
+			}
+			return {};
+		}
+		for (const auto& plan_t : plan_) { // Unpack the plan
+			ApplyTransition(plan_t);
+		}
+		plan_parts.Consume(realised->label().first, input);
+		plan_parts.Add(realised->label(), output);
+		if (key.has_value()) {
+			transpositions_.Insert(std::move(*key), { .end = &realised->to(), .realised = realised->label(), .plan = plan_ });
+		}
+		return &realised->to();
+	}
+
+	/**
+	 * @brief Depth first search over transfers for a state offering the operation. The search keeps an explicit stack
+	 * of frames and a single plan, which grow and shrink together as transfers are taken and backtracked, so the search
+	 * depth is not bounded by the call stack. States are expanded at most once per search, which cuts transfer cycles.
+	 * @param excluded: a state treated as already expanded, the start state of a speculative search
+	 * @returns The transition performing the operation, with plan_ holding the transitions leading up to and including it,
+	 *          or nullptr if the operation is not realisable from the state, or the search was cancelled
+	 */
+	const Controller::TopologyEdge* Controller::SearchTransfers(const TopologyState& topology_state, const Observable& op,
+		const TopologyState* excluded) {
+		plan_.clear();
+		expanded_.clear();
+		if (excluded != nullptr) {
+			expanded_.insert(excluded);
+		}
+		if (!expanded_.insert(&topology_state).second) {
+			return nullptr;
+		}
+		if (frames_.empty()) {
+			frames_.emplace_back();
+		}
+		frames_[0].state = &topology_state;
+		frames_[0].next = 0;
+		if (const TopologyEdge* found = Expand(topology_state, op, frames_[0].transfers); found != nullptr) {
+			AppendRealising(&topology_state, found);
+			return found;
+		}
+
+		size_t depth = 0;
+		while (true) {
+			if (winner_ != nullptr && winner_->load(std::memory_order_relaxed) < branch_) {
+				return nullptr; // An earlier speculative branch has realised the operation
+			}
+			SearchFrame& frame = frames_[depth];
+			if (frame.next == frame.transfers.size()) {
+				if (depth == 0) {
+					return nullptr;
+				}
+				plan_.pop_back();
+				--depth;
+				continue;
+			}
+			const TransferCandidate& candidate = frame.transfers[frame.next++];
+			if (visited_.has_value()) {
+				if (!visited_->Insert(HashStrings(*candidate.to, kFnvOffsetBasis ^ Mix64(search_)))) {
+					continue;
+				}
+			} else if (!expanded_.insert(candidate.to).second) {
+				continue;
+			}
+			plan_.emplace_back(frame.state, candidate.label, candidate.to);
+			const TopologyState* next = candidate.to;
+			if (++depth == frames_.size()) {
+				frames_.emplace_back();
+			}
+			frames_[depth].state = next;
+			frames_[depth].next = 0;
+			if (const TopologyEdge* found = Expand(*next, op, frames_[depth].transfers); found != nullptr) {
+				AppendRealising(next, found);
+				return found;
+			}
+		}
+	}
+
+	/**
+	 * @brief Speculative depth first search. Each transfer out of the start state is a branch, searched depth first by
+	 * a worker controller of its own. The branch with the lowest index which realises the operation wins, and branches
+	 * with higher indices stop once a lower one has won. The branches before the winner failed, so every state they
+	 * reach cannot lead to the operation, and the winner finds the same plan as SearchTransfers() would have. The
+	 * branches run on the controller's own pool, started by the first speculative search and kept for the rest.
+	 * @returns The transition performing the operation, with plan_ holding the transitions leading up to and including it,
+	 *          or nullptr if the operation is not realisable from the state
+	 */
+	const Controller::TopologyEdge* Controller::SearchSpeculative(const TopologyState& topology_state, const Observable& op) {
+		plan_.clear();
+		std::vector<TransferCandidate> branches;
+		if (const TopologyEdge* found = Expand(topology_state, op, branches); found != nullptr) {
+			AppendRealising(&topology_state, found);
+			return found;
+		}
+		if (branches.empty()) {
+			return nullptr;
+		}
+
+		if (speculation_pool_ == nullptr) {
+			speculation_pool_ = std::make_unique<WorkStealingPool>(opts_.search_threads);
+			speculation_mutex_ = std::make_unique<std::mutex>();
+			ControllerOpts speculator_opts = opts_;
+			speculator_opts.search = SearchMode::kDepthFirst;
+			while (speculators_.size() < speculation_pool_->size()) {
+				speculators_.emplace_back(std::make_unique<Controller>(machine_, topology_, recipe_, speculator_opts));
+				speculators_.back()->topology_mutex_ = (topology_mutex_ != nullptr) ? topology_mutex_ : speculation_mutex_.get();
+			}
+		}
+		for (auto& speculator : speculators_) {
+			speculator->reachability_ = reachability_;
+		}
+
+		WorkStealingPool& pool = *speculation_pool_;
+		std::atomic<size_t> winner = kUnreachable;
+		std::vector<std::pair<const TopologyEdge*, std::vector<PlanTransition>>> results(branches.size());
+		pool.Run([&](size_t) {
+			for (size_t i = 0; i < branches.size(); ++i) {
+				pool.Spawn([&, i](size_t worker) {
+					if (winner.load(std::memory_order_relaxed) < i) {
+						return;
+					}
+					Controller& speculator = *speculators_[worker];
+					speculator.winner_ = &winner;
+					speculator.branch_ = i;
+					const TopologyEdge* found = speculator.SearchTransfers(*branches[i].to, op, &topology_state);
+					speculator.winner_ = nullptr;
+					if (found == nullptr) {
+						return;
+					}
+					results[i] = { found, std::move(speculator.plan_) };
+					size_t current = winner.load();
+					while (i < current && !winner.compare_exchange_weak(current, i)) {}
+				});
+			}
+		});
+		for (auto& speculator : speculators_) {
+			expansions_ += speculator->expansions_;
+			pruned_transfers_ += speculator->pruned_transfers_;
+			speculator->expansions_ = 0;
+			speculator->pruned_transfers_ = 0;
+		}
+
+		size_t won = winner.load();
+		if (won == kUnreachable) {
+			return nullptr;
+		}
+		plan_.emplace_back(&topology_state, std::move(branches[won].label), branches[won].to);
+		for (auto& plan_t : results[won].second) {
+			plan_.emplace_back(std::move(plan_t));
+		}
+		return results[won].first;
+	}
+
+	/**
+	 * @brief Shortest transfer path search, breadth first or A*. Nodes are expanded in order of transfers taken plus the
+	 * heuristic, ties in order of discovery. The A* heuristic is the fewest transfers any single resource needs to reach
+	 * a local state offering the operation. A transfer moves each resource at most one of its own transfer edges, so it
+	 * never overestimates and changes by at most one per transfer, which makes the first expansion of a state optimal.
+	 * States from which no resource can reach the operation are not queued at all.
+	 * @returns The transition performing the operation, with plan_ holding the transitions leading up to and including it,
+	 *          or nullptr if the operation is not realisable from the state
+	 */
+	const Controller::TopologyEdge* Controller::SearchShortest(const TopologyState& topology_state, const Observable& op) {
+		plan_.clear();
+		nodes_.clear();
+		depths_.clear();
+		const std::vector<std::unordered_map<std::string, size_t>>* distances =
+			(opts_.search == SearchMode::kAStar) ? &OperationDistances(op.name()) : nullptr;
+		auto heuristic = [&](const TopologyState& state) -> size_t {
+			if (distances == nullptr) {
+				return 0;
+			}
+			if (reachability_ != nullptr) {
+				if (auto id = reachability_->Find(state); id.has_value()) {
+					uint32_t distance = reachability_->Distance(*id, op.name());
+					if (distance == ReachabilityIndex::kUnreachable) {
+						return kUnreachable;
+					} else if (distance != ReachabilityIndex::kUnknown) {
+						return distance;
+					}
+				}
+			}
+			return Heuristic(state, *distances);
+		};
+
+		// Entries of (transfers + heuristic, node), lowest first
+		using QueueEntry = std::pair<size_t, size_t>;
+		std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+		if (size_t h = heuristic(topology_state); h != kUnreachable) {
+			nodes_.emplace_back(&topology_state, kUnreachable, std::vector<std::string>(), 0);
+			depths_.emplace(&topology_state, 0);
+			open.emplace(h, 0);
+		}
+
+		std::vector<TransferCandidate> transfers;
+		while (!open.empty()) {
+			size_t n = open.top().second;
+			open.pop();
+			const TopologyState* current = nodes_[n].state;
+			size_t depth = nodes_[n].transfers;
+			if (depths_.at(current) < depth) {
+				continue; // Reached by fewer transfers since being queued
+			}
+			if (const TopologyEdge* found = Expand(*current, op, transfers); found != nullptr) {
+				std::vector<size_t> path;
+				for (size_t i = n; i != 0; i = nodes_[i].parent) {
+					path.emplace_back(i);
+				}
+				for (auto it = path.rbegin(); it != path.rend(); ++it) {
+					plan_.emplace_back(nodes_[nodes_[*it].parent].state, nodes_[*it].label, nodes_[*it].state);
+				}
+				AppendRealising(current, found);
+				return found;
+			}
+			for (auto& candidate : transfers) {
+				if (visited_.has_value() && !visited_->Insert(HashStrings(*candidate.to, kFnvOffsetBasis ^ Mix64(search_)))) {
+					continue;
+				}
+				auto [it, inserted] = depths_.try_emplace(candidate.to, depth + 1);
+				if (!inserted) {
+					if (it->second <= depth + 1) {
+						continue;
+					}
+					it->second = depth + 1;
+				}
+				size_t h = heuristic(*candidate.to);
+				if (h == kUnreachable) {
+					continue;
+				}
+				nodes_.emplace_back(candidate.to, n, std::move(candidate.label), depth + 1);
+				open.emplace(depth + 1 + h, nodes_.size() - 1);
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Dijkstra search for the cheapest way to perform all operations of a composite operation in order. Nodes are
+	 * (topology state, stage) pairs: transfers keep the stage, performing the stage's operation advances it, and each
+	 * step costs StepCost(). Searching the whole composite at once lets a cheap resource win over one which offers the
+	 * first operation sooner but makes the rest expensive. Recipe transitions are still chained one after another.
+	 * @returns The state reached, with plan_ holding the transitions leading to it and realised_ those performing each
+	 *          operation, or nullopt if the composite operation is not realisable from the state
+	 */
+	std::optional<const Controller::TopologyState*> Controller::SearchCheapest(const CompositeOperation& co, const TopologyState& topology_state) {
+		plan_.clear();
+		realised_.clear();
+		cost_nodes_.clear();
+		const size_t stages = co.sequential.size();
+		std::vector<std::unordered_map<const TopologyState*, double, StateHash, StateEqual>> costs(stages + 1);
+
+		// Entries of (cost, node), cheapest first
+		using QueueEntry = std::pair<double, size_t>;
+		std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+		cost_nodes_.emplace_back(&topology_state, 0, kUnreachable, std::vector<std::string>(), 0.0, nullptr);
+		costs[0].emplace(&topology_state, 0.0);
+		open.emplace(0.0, 0);
+
+		auto relax = [&](const TopologyState* to, size_t stage, size_t parent, std::vector<std::string>&& label, double cost,
+			const TopologyEdge* realised) {
+			auto [it, inserted] = costs[stage].try_emplace(to, cost);
+			if (!inserted) {
+				if (it->second <= cost) {
+					return;
+				}
+				it->second = cost;
+			}
+			cost_nodes_.emplace_back(to, stage, parent, std::move(label), cost, realised);
+			open.emplace(cost, cost_nodes_.size() - 1);
+		};
+
+		std::vector<TransferCandidate> transfers;
+		std::vector<const TopologyEdge*> operations;
+		while (!open.empty()) {
+			auto [cost, n] = open.top();
+			open.pop();
+			const TopologyState* current = cost_nodes_[n].state;
+			size_t stage = cost_nodes_[n].stage;
+			if (costs[stage].at(current) < cost) {
+				continue; // Reached more cheaply since being queued
+			}
+			if (stage == stages) {
+				std::vector<size_t> path;
+				for (size_t i = n; i != 0; i = cost_nodes_[i].parent) {
+					path.emplace_back(i);
+				}
+				for (auto it = path.rbegin(); it != path.rend(); ++it) {
+					const CostNode& node = cost_nodes_[*it];
+					plan_.emplace_back(cost_nodes_[node.parent].state, node.label, node.state);
+					if (node.realised != nullptr) {
+						realised_.emplace_back(node.realised);
+					}
+				}
+				return current;
+			}
+
+			Expand(*current, std::get<0>(co.sequential[stage]), transfers, &operations);
+			for (const TopologyEdge* edge : operations) {
+				std::vector<std::string> label(num_of_resources_, "-");
+				label[edge->label().first] = edge->label().second;
+				double step = StepCost(*current, label, edge->to());
+				relax(&edge->to(), stage + 1, n, std::move(label), cost + step, edge);
+			}
+			for (auto& candidate : transfers) {
+				double step = StepCost(*current, candidate.label, *candidate.to);
+				relax(candidate.to, stage, n, std::move(candidate.label), cost + step, nullptr);
+			}
+		}
+		return {};
+	}
+
+	/*
+	 * @brief Performs the parallel operations of a composite operation, once its sequential operations are done, by the
+	 * shortest joint schedule SearchParallel() finds. Adds each operation's output parts at the resource performing it.
+	 */
+	std::optional<const Controller::TopologyState*> Controller::HandleParallel(const CompositeOperation& co, const TopologyState& topology_state,
+		Parts& plan_parts) {
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::lavender), "Handling {} parallel operations", co.parallel.size()));
+		auto end = SearchParallel(co, topology_state);
+		if (!end.has_value()) {
+			return {};
+		}
+		for (const auto& plan_t : plan_) {
+			ApplyTransition(plan_t);
+		}
+		for (const auto& [i, edge] : performed_) {
+			plan_parts.Consume(edge->label().first, std::get<1>(co.parallel[i]));
+		}
+		for (const auto& [i, edge] : performed_) {
+			plan_parts.Add(edge->label(), std::get<2>(co.parallel[i]));
+		}
+		return end;
+	}
+
+	/**
+	 * @brief Breadth first search for the shortest joint schedule of the parallel operations of a composite operation.
+	 * Nodes are (topology state, operations performed) pairs. Each controller step is either a transfer, or a joint step
+	 * performing any of the remaining operations at once on distinct resources, whose label has a slot per resource
+	 * taking part. Operations on distinct resources change only their own local states, so a joint step reaches the
+	 * state their transitions would reach one after another.
+	 * @returns The state reached, with plan_ holding the transitions leading to it and performed_ the operations each
+	 *          joint step performed, or nullopt if the parallel operations are not realisable from the state, in which
+	 *          case failed_operation_ is the first operation the search got no further than
+	 */
+	std::optional<const Controller::TopologyState*> Controller::SearchParallel(const CompositeOperation& co, const TopologyState& topology_state) {
+		plan_.clear();
+		performed_.clear();
+		joint_nodes_.clear();
+		const size_t k = co.parallel.size();
+		if (k > 64) {
+			throw std::invalid_argument(fmt::format("[Controller] {} parallel operations exceed the limit of 64", k));
+		}
+		const uint64_t all = (k == 64) ? UINT64_MAX : (uint64_t{ 1 } << k) - 1;
+		std::unordered_map<const TopologyState*, std::vector<uint64_t>, StateHash, StateEqual> seen;
+		auto visit = [&seen](const TopologyState* state, uint64_t done) {
+			std::vector<uint64_t>& masks = seen[state];
+			if (std::find(masks.begin(), masks.end(), done) != masks.end()) {
+				return false;
+			}
+			masks.emplace_back(done);
+			return true;
+		};
+
+		joint_nodes_.emplace_back(&topology_state, 0, kUnreachable, std::vector<std::string>(), std::vector<std::pair<size_t, const TopologyEdge*>>());
+		visit(&topology_state, 0);
+		uint64_t furthest = 0;
+		std::vector<TransferCandidate> transfers;
+		std::vector<std::vector<const TopologyEdge*>> offers(k);
+		std::vector<TransferCandidate> candidates;
+		std::vector<std::pair<size_t, const TopologyEdge*>> chosen;
+		std::vector<bool> busy(num_of_resources_, false);
+		for (size_t n = 0; n < joint_nodes_.size(); ++n) {
+			const TopologyState* current = joint_nodes_[n].state;
+			uint64_t done = joint_nodes_[n].done;
+			if (std::popcount(done) > std::popcount(furthest)) {
+				furthest = done;
+			}
+			if (done == all) {
+				std::vector<size_t> path;
+				for (size_t i = n; i != 0; i = joint_nodes_[i].parent) {
+					path.emplace_back(i);
+				}
+				for (auto it = path.rbegin(); it != path.rend(); ++it) {
+					const JointNode& node = joint_nodes_[*it];
+					plan_.emplace_back(joint_nodes_[node.parent].state, node.label, node.state);
+					performed_.insert(performed_.end(), node.performed.begin(), node.performed.end());
+				}
+				return current;
+			}
+
+			// The transfers towards any remaining operation, and the transitions performing each of them
+			candidates.clear();
+			for (size_t i = 0; i < k; ++i) {
+				offers[i].clear();
+				if ((done >> i) & 1) {
+					continue;
+				}
+				Expand(*current, std::get<0>(co.parallel[i]), transfers, &offers[i]);
+				std::move(transfers.begin(), transfers.end(), std::back_inserter(candidates));
+			}
+			for (auto& candidate : candidates) {
+				if (visit(candidate.to, done)) {
+					joint_nodes_.emplace_back(candidate.to, done, n, std::move(candidate.label), std::vector<std::pair<size_t, const TopologyEdge*>>());
+				}
+			}
+
+			// Every non-empty assignment of remaining operations to distinct resources offering them
+			std::function<void(size_t, uint64_t)> assign = [&](size_t i, uint64_t performed) {
+				if (i == k) {
+					if (chosen.empty()) {
+						return;
+					}
+					const TopologyState* to = JointStep(chosen);
+					if (!visit(to, done | performed)) {
+						return;
+					}
+					std::vector<std::string> label(num_of_resources_, "-");
+					for (const auto& [op, edge] : chosen) {
+						label[edge->label().first] = edge->label().second;
+					}
+					joint_nodes_.emplace_back(to, done | performed, n, std::move(label), chosen);
+					return;
+				}
+				assign(i + 1, performed);
+				for (const TopologyEdge* edge : offers[i]) {
+					size_t resource = edge->label().first;
+					if (busy[resource]) {
+						continue;
+					}
+					busy[resource] = true;
+					chosen.emplace_back(i, edge);
+					assign(i + 1, performed | (uint64_t{ 1 } << i));
+					chosen.pop_back();
+					busy[resource] = false;
+				}
+			};
+			assign(0, 0);
+		}
+		for (size_t i = 0; i < k; ++i) {
+			if (!((furthest >> i) & 1)) {
+				failed_operation_ = std::get<0>(co.parallel[i]).name();
+				break;
+			}
+		}
+		return {};
+	}
+
+	/*
+	 * @brief The state reached by performing the chosen operations together, from the state the first transition leaves.
+	 * Each transition after the first is found again from the state its predecessors reach, as the transition with the same label leading the
+	 * resource to the same local state.
+	 */
+	const Controller::TopologyState* Controller::JointStep(const std::vector<std::pair<size_t, const TopologyEdge*>>& performed) {
+		const TopologyState* state = &performed.front().second->to();
+		for (size_t i = 1; i < performed.size(); ++i) {
+			const TopologyEdge* edge = performed[i].second;
+			std::unique_lock<std::mutex> lock;
+			if (topology_mutex_ != nullptr) {
+				lock = std::unique_lock(*topology_mutex_);
+			}
+			const auto& transitions = topology_->at(*state).transitions_;
+			auto it = std::find_if(transitions.begin(), transitions.end(), [&](const TopologyEdge& t) {
+				return t.label() == edge->label() && t.to()[t.label().first] == edge->to()[t.label().first];
+			});
+			if (it == transitions.end()) {
+				throw std::logic_error("[Controller] Operations of a joint step are not independent");
+			}
+			state = &it->to();
+		}
+		return state;
+	}
+
+	/**
+	 * @brief Looks for the operation among the transitions of a topology state. Returns the transition performing it if
+	 * found, otherwise fills transfers with those to try from the state. When operations is given, every transition
+	 * performing the operation is collected there instead and the transfers are always filled.
+	 */
+	const Controller::TopologyEdge* Controller::Expand(const TopologyState& topology_state, const Observable& op,
+		std::vector<TransferCandidate>& candidates, std::vector<const TopologyEdge*>* operations) {
+		++expansions_;
+		candidates.clear();
+		if (operations != nullptr) {
+			operations->clear();
+		}
 		// map type - TransferOperation key, tuple<end_state, transition, inverse transition>
 		std::unordered_map<TransferOperation, std::tuple<const TopologyState*, const TopologyTransition*,
 			const TopologyTransition*>> transfers;
 
-		for (const auto& transition : topology_->at(topology_state).transitions_) {
+		std::unique_lock<std::mutex> lock;
+		if (topology_mutex_ != nullptr) {
+			lock = std::unique_lock(*topology_mutex_);
+		}
+		const auto& topology_transitions = topology_->at(topology_state).transitions_;
+		if (lock.owns_lock()) {
+			lock.unlock();
+		}
+		for (const auto& transition : topology_transitions) {
 			if (op.name() == transition.label().second) {
-				if (!input.empty()) {
-					bool allocate = true;
-					// allocate = plan_parts.Allocate(transition.label(), input);
-					if (!allocate) {
-						return {};
-					}
-				}
-				std::vector<std::string> vec(num_of_resources_, "-");
-				vec[transition.label().first] = transition.label().second;
-
-				plan_transitions.emplace_back(&topology_state, vec, &transition.to());
-				for (const auto& plan_t : plan_transitions) { // Unpack the plan
-					ApplyTransition(plan_t);
+				if (operations == nullptr) {
+					return &transition;
 				}
-				plan_parts.Add(transition.label(), output);
-				return { std::make_pair(&transition.to(), plan_parts) };
+				operations->emplace_back(&transition);
 			}
 			else {
 				std::optional<TransferOperation> opt = StringToTransfer(transition.label().second);
@@ -135,22 +983,128 @@ namespace pcs {
 			}
 		}
 
-		std::optional<std::pair<const TopologyState*, Parts>> found = std::nullopt;
+		const std::vector<bool>* relevant = opts_.prune_transfers ? &RelevantComponents(op.name()) : nullptr;
 		for (const auto& [k, v] : transfers) {
 			// map type - [ TransferOperation key, tuple<end_state, transition, inverse transition> ]
-			const TopologyState& state_vec = *std::get<0>(v);
+			if (std::get<0>(v) == nullptr || std::get<2>(v) == nullptr) {
+				continue;
+			}
+			if (relevant != nullptr && !(*relevant)[transfer_graph_->Component(std::get<1>(v)->first)]) {
+				++pruned_transfers_;
+				continue;
+			}
+			if (reachability_ != nullptr) {
+				auto id = reachability_->Find(*std::get<0>(v));
+				if (id.has_value() && reachability_->Distance(*id, op.name()) == ReachabilityIndex::kUnreachable) {
+					++pruned_transfers_;
+					continue;
+				}
+			}
 			std::vector<std::string> label_vec(num_of_resources_, "-");
 			label_vec[std::get<1>(v)->first] = k.name();
 			label_vec[std::get<2>(v)->first] = std::get<2>(v)->second;
 
 			// plan_parts.Synchronize(k.n(), std::get<2>(v)->first, input);
-			plan_transitions.emplace_back(&topology_state, label_vec, &state_vec);
-			found = HandleSequentialOperation(state_vec, plan_transitions, plan_parts, seq_tuple); // Recurse DFS
-			if (found) {
-				break;
+			candidates.emplace_back(std::get<0>(v), std::move(label_vec));
+		}
+		return nullptr;
+	}
+
+	/*
+	 * @brief Appends the transition performing the operation to the plan.
+	 */
+	void Controller::AppendRealising(const TopologyState* from, const TopologyEdge* edge) {
+		std::vector<std::string> vec(num_of_resources_, "-");
+		vec[edge->label().first] = edge->label().second;
+		plan_.emplace_back(from, std::move(vec), &edge->to());
+	}
+
+	/**
+	 * @brief For each resource, the fewest of its own transfers from each local state to a local state offering the
+	 * operation, by breadth first search backwards from those states. Computed once per operation.
+	 */
+	const std::vector<std::unordered_map<std::string, size_t>>& Controller::OperationDistances(const std::string& operation) {
+		auto [it, inserted] = distances_.try_emplace(operation);
+		if (!inserted) {
+			return it->second;
+		}
+		for (const auto& lts : machine_->resources()) {
+			std::unordered_map<std::string, std::vector<const std::string*>> predecessors;
+			std::vector<const std::string*> queue;
+			std::unordered_map<std::string, size_t>& distance = it->second.emplace_back();
+			for (const auto& [name, state] : lts.states()) {
+				for (const auto& t : state.transitions_) {
+					if (t.label() == operation && distance.emplace(name, 0).second) {
+						queue.emplace_back(&name);
+					}
+					if (IsTransferLabel(t.label())) {
+						predecessors[t.to()].emplace_back(&name);
+					}
+				}
+			}
+			for (size_t i = 0; i < queue.size(); ++i) {
+				size_t d = distance.at(*queue[i]);
+				for (const std::string* predecessor : predecessors[*queue[i]]) {
+					if (distance.emplace(*predecessor, d + 1).second) {
+						queue.emplace_back(predecessor);
+					}
+				}
 			}
 		}
-		return found;
+		return it->second;
+	}
+
+	/**
+	 * @brief For each component of the TransferGraph, whether any of its resources offers the operation. Transfers
+	 * within other components leave every resource able to perform the operation, and all their possible partners,
+	 * unchanged. Computed once per operation.
+	 */
+	const std::vector<bool>& Controller::RelevantComponents(const std::string& operation) {
+		if (!transfer_graph_.has_value()) {
+			transfer_graph_.emplace(machine_->resources());
+		}
+		auto [it, inserted] = relevant_components_.try_emplace(operation, transfer_graph_->NumOfComponents(), false);
+		if (!inserted) {
+			return it->second;
+		}
+		const auto& resources = machine_->resources();
+		for (size_t r = 0; r < resources.size(); ++r) {
+			for (const auto& [name, state] : resources[r].states()) {
+				if (std::any_of(state.transitions_.begin(), state.transitions_.end(), [&](const auto& t) { return t.label() == operation; })) {
+					it->second[transfer_graph_->Component(r)] = true;
+					break;
+				}
+			}
+		}
+		return it->second;
+	}
+
+	/*
+	 * @returns The fewest transfers any resource needs to offer the operation, or kUnreachable if none can
+	 */
+	size_t Controller::Heuristic(const TopologyState& topology_state, const std::vector<std::unordered_map<std::string, size_t>>& distances) const {
+		size_t h = kUnreachable;
+		for (size_t r = 0; r < distances.size(); ++r) {
+			if (auto it = distances[r].find(topology_state[r]); it != distances[r].end()) {
+				h = std::min(h, it->second);
+			}
+		}
+		return h;
+	}
+
+	/*
+	 * @returns The cost of a controller transition under the objective, from the costs of the participating resources
+	 */
+	double Controller::StepCost(const TopologyState& from, const ControllerTransition& label, const TopologyState& to) const {
+		double cost = 0.0;
+		for (size_t r = 0; r < label.size(); ++r) {
+			if (label[r] == "-") {
+				continue;
+			}
+			double resource_cost = machine_->costs(r).Cost(from[r], label[r], to[r]);
+			cost = (opts_.objective == CostObjective::kTotal) ? cost + resource_cost : std::max(cost, resource_cost);
+		}
+		return cost;
 	}
 
 
@@ -158,7 +1112,15 @@ namespace pcs {
 	 * @brief ApplyTransition will add a single transition to the controller
 	 */
 	void Controller::ApplyTransition(const PlanTransition& plan_t) {
+		if (decide_) {
+			return;
+		}
+		if (fragment_ != nullptr) {
+			*fragment_ = fragment_->Push(plan_t);
+			return;
+		}
 		controller_.AddTransition(*plan_t.from, plan_t.label, *plan_t.to);
+		plan_cost_ += StepCost(*plan_t.from, plan_t.label, *plan_t.to);
 		PCS_INFO(fmt::format(fmt::fg(fmt::color::royal_blue) | fmt::emphasis::bold,
 			"Adding controller transition from {} with label ({}) to {}", fmt::join(*plan_t.from, ","),
 			fmt::join(plan_t.label, ","), fmt::join(*plan_t.to, ",")));
@@ -174,5 +1136,4 @@ namespace pcs {
 
 /* 	 
 	@Cleanup: use TaskExpression instead of tuple type 
-	@Todo: guard operation in each recipe state being handled
 */
\ No newline at end of file
@@ -5,14 +5,160 @@
 #include "pcs/lts/lts.h"
 #include "pcs/operation/transfer.h"
 #include "pcs/controller/plan_transition.h"
+#include "pcs/controller/plan_list.h"
 #include "pcs/controller/parts.h"
+#include "pcs/controller/transposition.h"
+#include "pcs/controller/precheck.h"
+#include "pcs/controller/guard_predicate.h"
+#include "pcs/environment/transfer_graph.h"
+#include "pcs/topology/reachability.h"
+#include "pcs/common/bitstate.h"
+#include "pcs/common/work_stealing.h"
 
 #include <boost/container_hash/hash.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_set>
+#include <unordered_map>
 
 namespace pcs {
 
+	/**
+	 * @brief A transfer which the search may take from a topology state: the state reached and the controller label.
+	 */
+	struct TransferCandidate {
+		const std::vector<std::string>* to;
+		std::vector<std::string> label;
+	};
+
+	/**
+	 * @brief A topology state on the search stack, along with its transfers and the next one to try.
+	 */
+	struct SearchFrame {
+		const std::vector<std::string>* state;
+		std::vector<TransferCandidate> transfers;
+		size_t next = 0;
+	};
+
+	/**
+	 * @brief A topology state reached by the breadth first and A* searches, linked to the node it was reached from.
+	 */
+	struct SearchNode {
+		const std::vector<std::string>* state;
+		size_t parent;
+		std::vector<std::string> label;
+		size_t transfers;
+	};
+
+	/**
+	 * @brief A (topology state, stage) pair reached by the cheapest search, where stage counts the operations of the
+	 * composite operation performed so far. realised is set when the node was reached by performing an operation.
+	 */
+	struct CostNode {
+		const std::vector<std::string>* state;
+		size_t stage;
+		size_t parent;
+		std::vector<std::string> label;
+		double cost;
+		const Transition<std::pair<size_t, std::string>, std::vector<std::string>>* realised;
+	};
+
+	/**
+	 * @brief A (topology state, operations performed) pair reached by the parallel search, where done has a bit set for
+	 * each parallel operation of the composite operation performed so far. A node reached by a joint step lists the
+	 * operations it performed, by index, with the transitions realising them; performed is empty after a transfer.
+	 */
+	struct JointNode {
+		const std::vector<std::string>* state;
+		uint64_t done;
+		size_t parent;
+		std::vector<std::string> label;
+		std::vector<std::pair<size_t, const Transition<std::pair<size_t, std::string>, std::vector<std::string>>*>> performed;
+	};
+
+	/**
+	 * @brief The controller transitions added whilst handling one recipe transition on a worker thread. path holds the
+	 * index of each recipe transition taken from the recipe's initial state, ordering fragments as the sequential
+	 * controller would add them. plan extends the plan of the branch leading here, shared with sibling fragments, so
+	 * the fragment's own transitions are those pushed beyond the first base.
+	 */
+	struct BranchFragment {
+		std::vector<size_t> path;
+		PlanList plan;
+		size_t base = 0;
+		bool realised = false;
+	};
+
+	/**
+	 * @brief How the controller searches for transfers leading to a state which offers an operation. Depth first takes
+	 * the first transfer path it finds. Breadth first finds a path with the fewest transfers, as does A*, which is guided
+	 * by how many of its own transfers each resource needs to reach a local state offering the operation. Cheapest
+	 * minimises the cost of each composite operation as a whole, choosing both the transfers and the resources performing
+	 * its operations, see CostObjective. Speculative searches depth first below each transfer out of the start state
+	 * concurrently, and takes the first of those transfers that leads to the operation, so it finds the same plan as
+	 * depth first.
+	 */
+	enum class SearchMode {
+		kDepthFirst,
+		kBreadthFirst,
+		kAStar,
+		kCheapest,
+		kSpeculative
+	};
+
+	/**
+	 * @brief The cost of a controller transition, from the costs of the resource transitions taking part in it.
+	 * Total sums them, for the overall work or energy. Makespan takes the longest, as the resources of a transfer act
+	 * together whilst the controller transitions themselves take place one after another.
+	 */
+	enum class CostObjective {
+		kTotal,
+		kMakespan
+	};
+
+	/**
+	 * @brief Options for Controller.
+	 * @param memoise: answers repeated searches for an operation from the same topology state from a transposition
+	 *                 table, see Controller::transpositions()
+	 * @param search: the search used for each sequential operation
+	 * @param objective: what the cheapest search minimises, and what Controller::PlanCost() reports
+	 * @param threads: worker threads exploring recipe branches, zero for the hardware concurrency and one to process
+	 *                 the recipe on the calling thread
+	 * @param search_threads: worker threads of the speculative search, zero for the hardware concurrency. The pool is
+	 *                        kept by the controller, and shared out between the recipe workers when threads > 1
+	 * @param precheck: rejects recipes failing the Prechecker's necessary conditions before any search
+	 * @param prune_transfers: skips transfers between resources which are not connected to any resource offering the
+	 *                         operation in the TransferGraph, as these can never help to realise it
+	 */
+	struct ControllerOpts {
+		bool memoise = true;
+		SearchMode search = SearchMode::kDepthFirst;
+		CostObjective objective = CostObjective::kTotal;
+		size_t threads = 1;
+		size_t search_threads = 0;
+		bool precheck = false;
+		bool prune_transfers = false;
+	};
+
+	/**
+	 * @brief The outcome of Controller::Decide(). An unrealisable recipe names the first recipe transition which could
+	 * not be realised, its index among the transitions of its start state, and the operation which failed within it
+	 * (empty when the cheapest search rejects the composite operation as a whole, and the first parallel operation the
+	 * parallel search could not perform when the parallel operations fail). precheck tells whether the recipe
+	 * was rejected by the Prechecker, without searching.
+	 */
+	struct Realisability {
+		bool realisable = true;
+		std::string from;
+		std::string to;
+		size_t transition = 0;
+		std::string operation;
+		PrecheckFailure precheck = PrecheckFailure::kNone;
+	};
+
 	class Controller {
 	public:
 		using TopologyTransition = std::pair<size_t, std::string>;
@@ -20,26 +166,101 @@ namespace pcs {
 
 		using ControllerTransition = std::vector<std::string>;
 		using ControllerState = std::vector<std::string>;
+		using TopologyEdge = Transition<TopologyTransition, TopologyState>;
 	private:
+		struct StateHash {
+			size_t operator()(const TopologyState* state) const {
+				return boost::hash<TopologyState>()(*state);
+			}
+		};
+		struct StateEqual {
+			bool operator()(const TopologyState* a, const TopologyState* b) const {
+				return *a == *b;
+			}
+		};
+
 		LTS<std::vector<std::string>, std::vector<std::string>, boost::hash<std::vector<std::string>>> controller_;
 		const Environment* machine_;
 		const Recipe* recipe_;
 		ITopology* topology_;
+		std::shared_ptr<PartNames> part_names_;
 
 		size_t num_of_resources_;
+		std::vector<PlanTransition> plan_;
+		std::vector<SearchFrame> frames_;
+		std::unordered_set<const TopologyState*, StateHash, StateEqual> expanded_;
+		std::vector<SearchNode> nodes_;
+		std::unordered_map<const TopologyState*, size_t, StateHash, StateEqual> depths_;
+		std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> distances_;
+		size_t expansions_ = 0;
+		std::vector<CostNode> cost_nodes_;
+		std::vector<const TopologyEdge*> realised_;
+		std::vector<JointNode> joint_nodes_;
+		std::vector<std::pair<size_t, const TopologyEdge*>> performed_;
+		double plan_cost_ = 0.0;
+		PlanList* fragment_ = nullptr;
+		std::mutex* topology_mutex_ = nullptr;
+		std::unique_ptr<WorkStealingPool> speculation_pool_;
+		std::vector<std::unique_ptr<Controller>> speculators_;
+		std::unique_ptr<std::mutex> speculation_mutex_;
+		const std::atomic<size_t>* winner_ = nullptr;
+		size_t branch_ = 0;
+		bool decide_ = false;
+		std::string failed_operation_;
+		std::optional<Prechecker> prechecker_;
+		CompiledGuards guards_;
+		size_t disabled_ = 0;
+		std::optional<TransferGraph> transfer_graph_;
+		std::unordered_map<std::string, std::vector<bool>> relevant_components_;
+		size_t pruned_transfers_ = 0;
+		const ReachabilityIndex* reachability_ = nullptr;
+		ControllerOpts opts_;
+		TranspositionTable transpositions_;
+		std::optional<BitStateSet> visited_;
+		uint64_t search_ = 0;
 	public:
-		Controller(const Environment* machine, ITopology* topology, const Recipe* recipe);
+		Controller(const Environment* machine, ITopology* topology, const Recipe* recipe, const ControllerOpts& opts = {});
 		std::optional<const LTS<std::vector<std::string>, std::vector<std::string>, boost::hash<std::vector<std::string>>>*> Generate();
+		Realisability Decide();
+		Realisability Decide(const Recipe& recipe);
+
+		void set_bitstate(size_t bytes, size_t hashes = 3);
+		const BitStateSet* bitstate() const;
+		void set_reachability_index(const ReachabilityIndex* index);
+		const TranspositionTable& transpositions() const;
+		size_t NumOfExpansions() const;
+		size_t NumOfPrunedTransfers() const;
+		size_t NumOfDisabledTransitions() const;
+		double PlanCost() const;
 	private:
 
-		bool ProcessRecipe(const std::string& recipe_state, const TopologyState* topoloy_state, const Parts plan_parts);
+		bool ProcessRecipe(const std::string& recipe_state, const TopologyState* topoloy_state, Parts& plan_parts);
+		bool ProcessRecipeParallel(const std::string& recipe_state, const TopologyState* topology_state, const Parts& plan_parts);
+		PrecheckResult Precheck(const Recipe& recipe);
+		bool IsEnabled(const CompositeOperation& co, const TopologyState& topology_state, const Parts& plan_parts);
+		bool DecideRecipe(const std::string& recipe_state, const TopologyState* topology_state, Parts& plan_parts, Realisability& result);
 
-		std::optional<std::pair<const TopologyState*, Parts>> HandleComposite(const CompositeOperation& co, const std::vector<std::string>& topology_state,
-			Parts plan_parts);
+		std::optional<const TopologyState*> HandleComposite(const CompositeOperation& co, const std::vector<std::string>& topology_state,
+			Parts& plan_parts);
 
-		std::optional<std::pair<const TopologyState*, Parts>> HandleSequentialOperation(const std::vector<std::string>& topology_state,
-			std::vector<PlanTransition> plan_transitions, Parts plan_parts,
+		std::optional<const TopologyState*> HandleSequentialOperation(const std::vector<std::string>& topology_state, Parts& plan_parts,
 			const std::tuple<Observable, std::vector<std::string>, std::vector<std::string>>& seq_tuple);
+		const TopologyEdge* SearchTransfers(const TopologyState& topology_state, const Observable& op, const TopologyState* excluded = nullptr);
+		const TopologyEdge* SearchSpeculative(const TopologyState& topology_state, const Observable& op);
+		const TopologyEdge* SearchShortest(const TopologyState& topology_state, const Observable& op);
+		std::optional<const TopologyState*> SearchCheapest(const CompositeOperation& co, const TopologyState& topology_state);
+		std::optional<const TopologyState*> HandleParallel(const CompositeOperation& co, const TopologyState& topology_state,
+			Parts& plan_parts);
+		std::optional<const TopologyState*> SearchParallel(const CompositeOperation& co, const TopologyState& topology_state);
+		const TopologyState* JointStep(const std::vector<std::pair<size_t, const TopologyEdge*>>& performed);
+		const TopologyEdge* Expand(const TopologyState& topology_state, const Observable& op, std::vector<TransferCandidate>& transfers,
+			std::vector<const TopologyEdge*>* operations = nullptr);
+		void AppendRealising(const TopologyState* from, const TopologyEdge* edge);
+
+		const std::vector<std::unordered_map<std::string, size_t>>& OperationDistances(const std::string& operation);
+		const std::vector<bool>& RelevantComponents(const std::string& operation);
+		size_t Heuristic(const TopologyState& topology_state, const std::vector<std::unordered_map<std::string, size_t>>& distances) const;
+		double StepCost(const TopologyState& from, const ControllerTransition& label, const TopologyState& to) const;
 
 		void ApplyTransition(const PlanTransition& plan_t);
 		void ApplyAllTransitions(const std::span<PlanTransition>& plan_transitions);
@@ -0,0 +1,120 @@
+#include "pcs/controller/guard_predicate.h"
+
+#include <string>
+#include <vector>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	static constexpr size_t kWordBits = 64;
+
+	/*
+	 * @brief Splits a guard name of the form "<resource>=<local state>", if it is one.
+	 */
+	static std::optional<std::pair<size_t, std::string>> ParseStateTest(const std::string& name) {
+		size_t equals = name.find('=');
+		if (equals == std::string::npos || equals == 0) {
+			return {};
+		}
+		size_t resource = 0;
+		auto [end, ec] = std::from_chars(name.data(), name.data() + equals, resource);
+		if (ec != std::errc() || end != name.data() + equals) {
+			return {};
+		}
+		return std::make_pair(resource, name.substr(equals + 1));
+	}
+
+	/**
+	 * @param guard: the guard of a composite operation, its name and input parts
+	 * @param names: the part names to intern the input parts into, shared with the inventories the guard tests
+	 * @param num_resources: the number of resources, which a state test must name one of
+	 * @exception std::invalid_argument if a state test names a resource which does not exist
+	 */
+	GuardPredicate::GuardPredicate(const std::pair<Guard, std::vector<std::string>>& guard, PartNames& names, size_t num_resources) {
+		const auto& [op, input] = guard;
+		if (op.name().empty()) {
+			return;
+		}
+		kind_ = (op.name() == "absent") ? GuardKind::kAbsent : GuardKind::kPresent;
+		if (kind_ == GuardKind::kPresent) {
+			state_ = ParseStateTest(op.name());
+			if (state_.has_value() && state_->first >= num_resources) {
+				throw std::invalid_argument(fmt::format("[Guard] Guard {} tests resource {} of {}", op.name(), state_->first, num_resources));
+			}
+		}
+		std::unordered_map<uint32_t, size_t> counts;
+		for (const auto& part : input) {
+			uint32_t id = names.Intern(part);
+			if (id / kWordBits >= mask_.size()) {
+				mask_.resize((id / kWordBits) + 1, 0);
+			}
+			mask_[id / kWordBits] |= uint64_t{ 1 } << (id % kWordBits);
+			++counts[id];
+		}
+		for (const auto& [id, count] : counts) {
+			if (count > 1) {
+				copies_.emplace_back(id, count);
+			}
+		}
+	}
+
+	/**
+	 * @brief Whether the guard holds given the parts and the topology state the recipe transition starts from. Parts
+	 * consumed by earlier operations no longer count.
+	 */
+	bool GuardPredicate::Holds(const Parts& parts, const std::vector<std::string>& topology_state) const {
+		switch (kind_) {
+			case GuardKind::kAlways:
+				return true;
+			case GuardKind::kAbsent:
+				return !parts.Intersects(mask_);
+			case GuardKind::kPresent:
+				if (state_.has_value() && topology_state[state_->first] != state_->second) {
+					return false;
+				}
+				if (!parts.Includes(mask_)) {
+					return false;
+				}
+				for (const auto& [id, count] : copies_) {
+					if (parts.Total(id) < count) {
+						return false;
+					}
+				}
+				return true;
+		}
+		return true;
+	}
+
+	GuardKind GuardPredicate::kind() const {
+		return kind_;
+	}
+
+	CompiledGuards CompileGuards(const Recipe& recipe, PartNames& names, size_t num_resources) {
+		CompiledGuards guards;
+		for (const auto& [key, state] : recipe.lts().states()) {
+			for (const auto& t : state.transitions_) {
+				if (t.label().HasGuard()) {
+					guards.try_emplace(&t.label(), t.label().guard, names, num_resources);
+				}
+			}
+		}
+		return guards;
+	}
+
+	const char* ToString(GuardKind kind) {
+		switch (kind) {
+			case GuardKind::kAlways:
+				return "always";
+			case GuardKind::kPresent:
+				return "present";
+			case GuardKind::kAbsent:
+				return "absent";
+		}
+		return "unknown";
+	}
+
+}
\ No newline at end of file
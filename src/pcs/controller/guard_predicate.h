@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+#include "pcs/controller/parts.h"
+#include "pcs/operation/guard.h"
+#include "pcs/operation/composite.h"
+#include "pcs/product/recipe.h"
+#include "pcs/product/part_names.h"
+
+namespace pcs {
+
+	enum class GuardKind {
+		kAlways,
+		kPresent,
+		kAbsent
+	};
+
+	/**
+	 * @brief A recipe guard compiled to a test over the parts inventory and the topology state, deciding whether a
+	 * recipe transition is enabled. The guard's name selects the test on its input parts:
+	 *  - no guard: always holds
+	 *  - "absent": none of the input parts is present at any resource
+	 *  - "<resource>=<local state>", e.g. "1=s2": the resource is in the local state, and the input parts are present
+	 *  - any other name, e.g. "check": every input part is present at some resource, counting repeated parts
+	 * The parts are held as a bitset over interned ids, so testing them is a few AND/OR operations over the inventory.
+	 * The controller consumes the input parts of every operation it performs (Parts::Consume), so a guard tests the
+	 * parts still in the inventory: "absent" holds again once the parts have been used up, and the others stop holding.
+	 */
+	class GuardPredicate {
+	private:
+		GuardKind kind_ = GuardKind::kAlways;
+		std::vector<uint64_t> mask_;
+		std::vector<std::pair<uint32_t, size_t>> copies_;
+		std::optional<std::pair<size_t, std::string>> state_;
+	public:
+		GuardPredicate() = default;
+		GuardPredicate(const std::pair<Guard, std::vector<std::string>>& guard, PartNames& names, size_t num_resources);
+
+		bool Holds(const Parts& parts, const std::vector<std::string>& topology_state) const;
+		GuardKind kind() const;
+	};
+
+	/**
+	 * @brief The guards of every recipe transition, compiled once, by the address of the transition's label.
+	 */
+	using CompiledGuards = std::unordered_map<const CompositeOperation*, GuardPredicate>;
+	CompiledGuards CompileGuards(const Recipe& recipe, PartNames& names, size_t num_resources);
+
+	const char* ToString(GuardKind kind);
+}
\ No newline at end of file
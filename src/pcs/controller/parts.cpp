@@ -1,8 +1,13 @@
 #include "pcs/controller/parts.h"
 
+#include <bit>
 #include <vector>
 #include <string>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <algorithm>
+#include <stdexcept>
 
 #include "spdlog/fmt/ostr.h"
 
@@ -16,27 +21,37 @@ namespace pcs {
 	using ControllerState = std::vector<std::string>;
 	using ControllerTransition = std::vector<std::string>;
 
+	static constexpr size_t kWordBits = 64;
+
 	// ==========================
 	// Constructors & destructor
 	// ==========================
 
-	Parts::Parts(size_t num_resources) {
-		parts_.resize(num_resources, std::vector<std::string>());
-	}
+	/**
+	 * @param num_resources: the number of resources holding parts
+	 * @param names: the part names to intern into, usually the recipe's, or a fresh table if null. Chunks are sized for
+	 *               the names it already holds, so that interning the recipe's parts up front means they never grow.
+	 */
+	Parts::Parts(size_t num_resources, std::shared_ptr<PartNames> names)
+		: names_(names ? std::move(names) : std::make_shared<PartNames>()), resources_(num_resources) {}
 
 	Parts::Parts(const Parts& other) 
-		: parts_(other.parts_) {}
+		: names_(other.names_), resources_(other.resources_), log_(other.log_) {}
 	
 	Parts& Parts::operator=(const Parts& other) {
-		parts_ = other.parts_;
+		names_ = other.names_;
+		resources_ = other.resources_;
+		log_ = other.log_;
 		return *this;
 	}
 
 	Parts::Parts(Parts&& other) noexcept 
-		: parts_(std::move(other.parts_)) {}
+		: names_(std::move(other.names_)), resources_(std::move(other.resources_)), log_(std::move(other.log_)) {}
 
 	Parts& Parts::operator=(Parts&& other) noexcept {
-		parts_ = std::move(other.parts_);
+		names_ = std::move(other.names_);
+		resources_ = std::move(other.resources_);
+		log_ = std::move(other.log_);
 		return *this;
 	}
 
@@ -44,8 +59,92 @@ namespace pcs {
 	// Member functions
 	// ==========================
 
-	const std::vector<std::string>& Parts::AtResource(size_t resource) const {
-		return parts_[resource];
+	/**
+	 * @brief The parts at the resource, ordered by id (i.e. by first appearance in the recipe), each repeated as many
+	 * times as there are copies.
+	 */
+	std::vector<std::string> Parts::AtResource(size_t resource) const {
+		std::vector<std::string> parts;
+		if (resources_[resource] == nullptr) {
+			return parts;
+		}
+		const ResourceParts& chunk = *resources_[resource];
+		for (size_t w = 0; w < chunk.present.size(); ++w) {
+			for (uint64_t bits = chunk.present[w]; bits != 0; bits &= bits - 1) {
+				uint32_t part = static_cast<uint32_t>(w * kWordBits + std::countr_zero(bits));
+				parts.insert(parts.end(), chunk.counts[part], names_->Name(part));
+			}
+		}
+		return parts;
+	}
+
+	/**
+	 * @brief The number of copies of the interned part at the resource.
+	 */
+	size_t Parts::Count(size_t resource, uint32_t part) const {
+		const ResourceParts* chunk = resources_[resource].get();
+		if (chunk == nullptr || part >= chunk->counts.size()) {
+			return 0;
+		}
+		return chunk->counts[part];
+	}
+
+	/**
+	 * @brief The number of copies of the interned part over all resources.
+	 */
+	size_t Parts::Total(uint32_t part) const {
+		size_t total = 0;
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			total += Count(r, part);
+		}
+		return total;
+	}
+
+	/**
+	 * @brief Whether every part in the bitset of part ids is present at some resource.
+	 */
+	bool Parts::Includes(const std::vector<uint64_t>& mask) const {
+		for (size_t w = 0; w < mask.size(); ++w) {
+			uint64_t present = 0;
+			for (size_t r = 0; r < resources_.size(); ++r) {
+				if (w < Words(r)) {
+					present |= resources_[r]->present[w];
+				}
+			}
+			if ((present & mask[w]) != mask[w]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Whether any part in the bitset of part ids is present at some resource.
+	 */
+	bool Parts::Intersects(const std::vector<uint64_t>& mask) const {
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			for (size_t w = 0; w < std::min(mask.size(), Words(r)); ++w) {
+				if ((resources_[r]->present[w] & mask[w]) != 0) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	const PartNames& Parts::names() const {
+		return *names_;
+	}
+
+	/**
+	 * @brief A snapshot to explore a branch from independently, e.g. on another thread. It shares every chunk with this
+	 * inventory until either changes it, and starts with an empty change log.
+	 */
+	Parts Parts::Fork() const {
+		Parts fork;
+		fork.names_ = names_;
+		fork.resources_ = resources_;
+		return fork;
 	}
 
 	/**
@@ -58,7 +157,12 @@ namespace pcs {
 			fmt::join(output, ","), transition.first));
 		
 		for (const auto& part : output) {
-			parts_[transition.first].emplace_back(part);
+			uint32_t id = Intern(part);
+			if (Count(transition.first, id) == UINT16_MAX) {
+				throw std::overflow_error(fmt::format("[Parts] Too many copies of part {} at resource {}", part, transition.first));
+			}
+			Change(transition.first, id, 1, true);
+			log_.emplace_back(transition.first, id, uint16_t{ 1 }, true);
 		}
 	}
 
@@ -73,19 +177,23 @@ namespace pcs {
 		size_t count = 0;
 		size_t input_size = input.size();
 
-		auto end = std::remove_if(parts_[out].begin(), parts_[out].end(),
-			[&](const auto& i) {
-				if (std::find(input.begin(), input.end(), i) != input.end()) {
-					count++;
-					parts_[in].emplace_back(i);
-					return true;
-				}
-				else {
-					return false;
+		size_t words = Words(out);
+		std::vector<uint64_t> mask = Mask(input, words);
+		for (size_t w = 0; w < words; ++w) {
+			uint64_t moved = resources_[out]->present[w] & mask[w];
+			for (uint64_t bits = moved; bits != 0; bits &= bits - 1) {
+				uint32_t part = static_cast<uint32_t>(w * kWordBits + std::countr_zero(bits));
+				uint16_t copies = static_cast<uint16_t>(Count(out, part));
+				if (Count(in, part) + copies > UINT16_MAX) {
+					throw std::overflow_error(fmt::format("[Parts Sync] Too many copies of part {} at resource {}", names_->Name(part), in));
 				}
-			});
-
-		parts_[out].erase(end, parts_[out].end());
+				count += copies;
+				Change(out, part, copies, false);
+				Change(in, part, copies, true);
+				log_.emplace_back(out, part, copies, false);
+				log_.emplace_back(in, part, copies, true);
+			}
+		}
 
 		if (count != input_size) {
 			PCS_WARN(fmt::format(fmt::fg(fmt::color::light_yellow) | fmt::emphasis::underline, 
@@ -107,20 +215,18 @@ namespace pcs {
 		size_t input_size = input.size();
 		size_t resource = transition.first;
 
-		// PCS_INFO("Allocate Parts: {} at resource {}", *this, resource);
-
-		auto end = std::remove_if(parts_[resource].begin(), parts_[resource].end(),
-			[&](const auto& i) {
-				if (std::find(input.begin(), input.end(), i) != input.end()) {
-					PCS_INFO(fmt::format(fmt::fg(fmt::color::coral), "[Parts] Consuming part {} at resource {}", resource, i));
-					count++;
-					return true;
-				} else {
-					return false;
-				}
-			});
-
-		parts_[resource].erase(end, parts_[resource].end());
+		size_t words = Words(resource);
+		std::vector<uint64_t> mask = Mask(input, words);
+		for (size_t w = 0; w < words; ++w) {
+			for (uint64_t bits = resources_[resource]->present[w] & mask[w]; bits != 0; bits &= bits - 1) {
+				uint32_t part = static_cast<uint32_t>(w * kWordBits + std::countr_zero(bits));
+				PCS_INFO(fmt::format(fmt::fg(fmt::color::coral), "[Parts] Consuming part {} at resource {}", names_->Name(part), resource));
+				uint16_t copies = static_cast<uint16_t>(Count(resource, part));
+				count += copies;
+				Change(resource, part, copies, false);
+				log_.emplace_back(resource, part, copies, false);
+			}
+		}
 
 		if (count != input_size) {
 			PCS_WARN(fmt::format(fmt::fg(fmt::color::light_yellow) | fmt::emphasis::underline, "[Parts] Not all parts were found at resource {} from set: {}", resource,
@@ -131,19 +237,179 @@ namespace pcs {
 		return true;
 	}
 
+	/*
+	 * @brief Consumes one copy of each input part for an operation performed at the resource. A part the resource does
+	 * not hold is taken from the lowest numbered resource which does, as the transfers leading to the operation are
+	 * assumed to have brought it along.
+	 * @param input: the operation's input parts, a part listed twice consumes two copies
+	 * @returns True if every input part was found, false if some were missing (the rest are still consumed)
+	 */
+	bool Parts::Consume(size_t resource, const std::vector<std::string>& input) {
+		bool found = true;
+		for (const auto& name : input) {
+			std::optional<uint32_t> id = names_ ? names_->Find(name) : std::nullopt;
+			size_t from = resource;
+			if (id.has_value() && Count(from, *id) == 0) {
+				for (from = 0; from < resources_.size() && Count(from, *id) == 0; ++from) {}
+			}
+			if (!id.has_value() || from == resources_.size()) {
+				found = false;
+				continue;
+			}
+			PCS_INFO(fmt::format(fmt::fg(fmt::color::coral), "[Parts] Consuming part {} at resource {}", name, from));
+			Change(from, *id, 1, false);
+			log_.emplace_back(from, *id, uint16_t{ 1 }, false);
+		}
+		if (!found) {
+			PCS_WARN(fmt::format(fmt::fg(fmt::color::light_yellow) | fmt::emphasis::underline, "[Parts] Not all parts were found for resource {} from set: {}",
+				resource, fmt::join(input, ",")));
+		}
+		return found;
+	}
+
+	/*
+	 * @brief The (resource, part id, count) triples of every part present, resource by resource in id order, so that
+	 * inventories which differ only in arrival order compare equal. Only comparable between inventories sharing names.
+	 */
+	std::vector<uint32_t> Parts::Canonical() const {
+		std::vector<uint32_t> canonical;
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			for (size_t w = 0; w < Words(r); ++w) {
+				for (uint64_t bits = resources_[r]->present[w]; bits != 0; bits &= bits - 1) {
+					uint32_t part = static_cast<uint32_t>(w * kWordBits + std::countr_zero(bits));
+					canonical.insert(canonical.end(), { static_cast<uint32_t>(r), part, static_cast<uint32_t>(Count(r, part)) });
+				}
+			}
+		}
+		return canonical;
+	}
+
+	/*
+	 * @brief A position in the change log to Rollback() to, e.g. before trying a branch of a search.
+	 */
+	size_t Parts::Checkpoint() const {
+		return log_.size();
+	}
+
+	/*
+	 * @brief Undoes every change made since the checkpoint, newest first, restoring the parts exactly.
+	 */
+	void Parts::Rollback(size_t checkpoint) {
+		while (log_.size() > checkpoint) {
+			const PartsChange& change = log_.back();
+			Change(change.resource, change.part, change.count, !change.added);
+			log_.pop_back();
+		}
+	}
+
+	/*
+	 * @brief Compares the parts at each resource. Inventories with their own names compare by name.
+	 */
 	bool Parts::operator==(const Parts& other) const {
-		return parts_ == other.parts_;
+		if (resources_.size() != other.resources_.size()) {
+			return false;
+		}
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			if (resources_[r] == other.resources_[r]) {
+				continue;
+			}
+			if (names_ != other.names_) {
+				std::vector<std::string> parts = AtResource(r);
+				std::vector<std::string> other_parts = other.AtResource(r);
+				std::sort(parts.begin(), parts.end());
+				std::sort(other_parts.begin(), other_parts.end());
+				if (parts != other_parts) {
+					return false;
+				}
+				continue;
+			}
+			size_t parts = std::max(Words(r), other.Words(r)) * kWordBits;
+			for (uint32_t part = 0; part < parts; ++part) {
+				if (Count(r, part) != other.Count(r, part)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * @brief The id of the part name, interning it if needed.
+	 */
+	uint32_t Parts::Intern(const std::string& name) {
+		if (!names_) {
+			names_ = std::make_shared<PartNames>();
+		}
+		return names_->Intern(name);
+	}
+
+	/*
+	 * @brief A bitset of the named parts over the given number of words. Names which are not interned, or lie beyond
+	 * the words, cannot be present and are left out.
+	 */
+	std::vector<uint64_t> Parts::Mask(const std::vector<std::string>& input, size_t words) const {
+		std::vector<uint64_t> mask(words, 0);
+		if (!names_) {
+			return mask;
+		}
+		for (const auto& name : input) {
+			if (auto id = names_->Find(name); id.has_value() && *id < words * kWordBits) {
+				mask[*id / kWordBits] |= uint64_t{ 1 } << (*id % kWordBits);
+			}
+		}
+		return mask;
+	}
+
+	/*
+	 * @brief The number of bitset words at the resource, zero whilst it has never held parts.
+	 */
+	size_t Parts::Words(size_t resource) const {
+		return (resources_[resource] == nullptr) ? 0 : resources_[resource]->present.size();
 	}
 
+	/*
+	 * @brief The resource's chunk, to be changed in place: copied first if another inventory shares it, and widened to
+	 * hold the part.
+	 */
+	ResourceParts& Parts::Mutable(size_t resource, uint32_t part) {
+		std::shared_ptr<ResourceParts>& chunk = resources_[resource];
+		if (chunk == nullptr) {
+			chunk = std::make_shared<ResourceParts>();
+		} else if (chunk.use_count() > 1) {
+			chunk = std::make_shared<ResourceParts>(*chunk);
+		} else {
+			// Sole owner: order the other owners' reads of the chunk, before they released it, before our writes
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		size_t words = std::max({ chunk->present.size(), (part / kWordBits) + 1, (names_->size() + kWordBits - 1) / kWordBits });
+		if (words > chunk->present.size()) {
+			chunk->present.resize(words, 0);
+			chunk->counts.resize(words * kWordBits, 0);
+		}
+		return *chunk;
+	}
+
+	/*
+	 * @brief Adds or removes copies of the part at the resource, keeping its bit set exactly whilst any remain.
+	 */
+	void Parts::Change(size_t resource, uint32_t part, uint16_t count, bool added) {
+		ResourceParts& chunk = Mutable(resource, part);
+		uint16_t& copies = chunk.counts[part];
+		copies = added ? static_cast<uint16_t>(copies + count) : static_cast<uint16_t>(copies - count);
+		uint64_t bit = uint64_t{ 1 } << (part % kWordBits);
+		uint64_t& word = chunk.present[part / kWordBits];
+		word = (copies != 0) ? (word | bit) : (word & ~bit);
+	}
 
 	std::ostream& operator<<(std::ostream& os, const Parts& parts) {
-		for (size_t i = 0; i < parts.parts_.size(); ++i) {
-			if (parts.parts_[i].empty()) {
+		for (size_t i = 0; i < parts.resources_.size(); ++i) {
+			std::vector<std::string> at = parts.AtResource(i);
+			if (at.empty()) {
 				continue;
 			}
 			os << "Parts at Resource " << (i) << ':';
 			os << "  ";
-			for (const auto& p : parts.parts_[i]) {
+			for (const auto& p : at) {
 				os << p << " ";
 			}
 			os << "\n";
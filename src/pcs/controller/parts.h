@@ -1,10 +1,39 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
+#include "pcs/product/part_names.h"
+
 namespace pcs {
 
+	/**
+	 * @brief Copies of a single part entering or leaving a resource, recorded by Parts so that they can be rolled back.
+	 */
+	struct PartsChange {
+		size_t resource;
+		uint32_t part;
+		uint16_t count;
+		bool added;
+	};
+
+	/**
+	 * @brief The parts at a single resource: a bitset of the parts present, and the number of copies of each.
+	 */
+	struct ResourceParts {
+		std::vector<uint64_t> present;
+		std::vector<uint16_t> counts;
+	};
+
+	/**
+	 * @brief The parts at each resource, as a multiset of interned part ids. Each resource holds a bitset of the parts
+	 * present along with a count per part, so allocating and transferring parts are AND/ANDNOT/OR over the bitsets.
+	 * Resources are copy-on-write chunks shared between copies, so copying an inventory copies a pointer per resource
+	 * and a change copies only the chunk of the resource it touches. Inventories sharing a PartNames table compare and
+	 * hash by id.
+	 */
 	class Parts {
 	public:
 		using TopologyState = std::vector<std::string>;
@@ -13,24 +42,44 @@ namespace pcs {
 		using ControllerState = std::vector<std::string>;
 		using ControllerTransition = std::vector<std::string>;
 	private:
-		std::vector<std::vector<std::string>> parts_;
+		std::shared_ptr<PartNames> names_;
+		std::vector<std::shared_ptr<ResourceParts>> resources_;
+		std::vector<PartsChange> log_;
 	public:
 		Parts() = default;
-		Parts(size_t num_resources);
+		Parts(size_t num_resources, std::shared_ptr<PartNames> names = nullptr);
 		Parts(const Parts& other);
 		Parts& operator=(const Parts& other);
 		Parts(Parts&& other) noexcept;
 		Parts& operator=(Parts&& other) noexcept;
 
-		const std::vector<std::string>& AtResource(size_t resource) const;
+		std::vector<std::string> AtResource(size_t resource) const;
+		size_t Count(size_t resource, uint32_t part) const;
+		size_t Total(uint32_t part) const;
+		bool Includes(const std::vector<uint64_t>& mask) const;
+		bool Intersects(const std::vector<uint64_t>& mask) const;
+		const PartNames& names() const;
+		Parts Fork() const;
 
 		void Add(const TopologyTransition& transition, const std::vector<std::string>& output);
 		bool Synchronize(size_t in, size_t out, const std::vector<std::string>& input);
 		bool Allocate(const TopologyTransition& transition, const std::vector<std::string>& input);
+		bool Consume(size_t resource, const std::vector<std::string>& input);
+
+		std::vector<uint32_t> Canonical() const;
+
+		size_t Checkpoint() const;
+		void Rollback(size_t checkpoint);
 
 		bool operator==(const Parts& other) const;
 
 		friend std::ostream& operator<<(std::ostream& os, const Parts& parts);
+	private:
+		uint32_t Intern(const std::string& name);
+		std::vector<uint64_t> Mask(const std::vector<std::string>& input, size_t words) const;
+		size_t Words(size_t resource) const;
+		ResourceParts& Mutable(size_t resource, uint32_t part);
+		void Change(size_t resource, uint32_t part, uint16_t count, bool added);
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "pcs/controller/plan_list.h"
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+namespace pcs {
+
+	/**
+	 * @brief A list holding the transitions in order, the last at the front.
+	 */
+	PlanList::PlanList(const std::vector<PlanTransition>& transitions) {
+		for (const auto& transition : transitions) {
+			*this = Push(transition);
+		}
+	}
+
+	/*
+	 * @brief Releases the nodes no other list shares one by one, as the default destructor would recurse down the list.
+	 */
+	PlanList::~PlanList() {
+		while (head_ != nullptr && head_.use_count() == 1) {
+			head_ = std::move(head_->next);
+		}
+	}
+
+	PlanList PlanList::Push(PlanTransition transition) const {
+		PlanList list;
+		list.head_ = std::make_shared<Node>(std::move(transition), head_, size() + 1);
+		return list;
+	}
+
+	/**
+	 * @brief The list without its newest transition.
+	 */
+	PlanList PlanList::Pop() const {
+		if (head_ == nullptr) {
+			throw std::out_of_range("[Plan List] Pop from an empty plan");
+		}
+		PlanList list;
+		list.head_ = head_->next;
+		return list;
+	}
+
+	const PlanTransition& PlanList::front() const {
+		if (head_ == nullptr) {
+			throw std::out_of_range("[Plan List] Front of an empty plan");
+		}
+		return head_->transition;
+	}
+
+	bool PlanList::empty() const {
+		return head_ == nullptr;
+	}
+
+	size_t PlanList::size() const {
+		return (head_ == nullptr) ? 0 : head_->size;
+	}
+
+	/**
+	 * @brief The newest count transitions, in the order they were pushed.
+	 */
+	std::vector<PlanTransition> PlanList::ToVector(size_t count) const {
+		std::vector<PlanTransition> transitions;
+		ForEach([&transitions](const PlanTransition& transition) { transitions.emplace_back(transition); }, count);
+		return transitions;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "pcs/controller/plan_transition.h"
+
+namespace pcs {
+
+	/**
+	 * @brief An immutable list of planned transitions, the newest at the front. Pushing returns a new list which
+	 * shares every existing node, so copying or forking a plan is O(1) and sibling branches share their common prefix.
+	 */
+	class PlanList {
+	private:
+		struct Node {
+			PlanTransition transition;
+			std::shared_ptr<Node> next;
+			size_t size;
+		};
+
+		std::shared_ptr<Node> head_;
+	public:
+		PlanList() = default;
+		PlanList(const std::vector<PlanTransition>& transitions);
+		PlanList(const PlanList& other) = default;
+		PlanList& operator=(const PlanList& other) = default;
+		PlanList(PlanList&& other) noexcept = default;
+		PlanList& operator=(PlanList&& other) noexcept = default;
+		~PlanList();
+
+		PlanList Push(PlanTransition transition) const;
+		PlanList Pop() const;
+		const PlanTransition& front() const;
+
+		bool empty() const;
+		size_t size() const;
+
+		/**
+		 * @brief Calls f on the newest count transitions, in the order they were pushed.
+		 */
+		template <typename F>
+		void ForEach(F&& f, size_t count = SIZE_MAX) const {
+			std::vector<const PlanTransition*> transitions;
+			for (const Node* node = head_.get(); node != nullptr && transitions.size() < count; node = node->next.get()) {
+				transitions.emplace_back(&node->transition);
+			}
+			for (auto it = transitions.rbegin(); it != transitions.rend(); ++it) {
+				f(**it);
+			}
+		}
+
+		std::vector<PlanTransition> ToVector(size_t count = SIZE_MAX) const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "pcs/controller/precheck.h"
+
+#include <set>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+#include "pcs/environment/prune.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	/**
+	 * @brief Collects the operations offered by the resources, and those offered in local states reachable from the
+	 * initial states. Transfers count towards reachability only if another resource can synchronise with them, as in
+	 * PruneResources().
+	 */
+	Prechecker::Prechecker(const Environment& machine, const PrecheckOpts& opts) : opts_(opts) {
+		const auto& resources = machine.resources();
+		std::vector<std::set<std::string>> labels(resources.size());
+		for (size_t r = 0; r < resources.size(); ++r) {
+			for (const auto& [name, state] : resources[r].states()) {
+				for (const auto& t : state.transitions_) {
+					labels[r].insert(t.label());
+					if (!IsTransferLabel(t.label())) {
+						offered_.insert(t.label());
+					}
+				}
+			}
+		}
+
+		for (size_t r = 0; r < resources.size(); ++r) {
+			std::unordered_set<std::string> live;
+			for (const auto& label : labels[r]) {
+				if (IsTransferLabel(label) && IsLiveTransfer(labels, r, label)) {
+					live.insert(label);
+				}
+			}
+			const LTS<std::string, std::string>& lts = resources[r];
+			if (!lts.HasState(lts.initial_state())) {
+				continue;
+			}
+			std::unordered_set<std::string> reached = { lts.initial_state() };
+			std::vector<const std::string*> stack = { &lts.initial_state() };
+			while (!stack.empty()) {
+				const std::string* state = stack.back();
+				stack.pop_back();
+				for (const auto& t : lts[*state].transitions_) {
+					if (!IsTransferLabel(t.label())) {
+						reachable_.insert(t.label());
+					} else if (!live.contains(t.label())) {
+						continue;
+					}
+					if (reached.insert(t.to()).second) {
+						stack.emplace_back(&t.to());
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Checks the recipe transitions reachable from the recipe's initial state, in breadth first order.
+	 */
+	PrecheckResult Prechecker::Check(const Recipe& recipe) const {
+		const auto& lts = recipe.lts();
+		std::vector<const std::string*> queue = { &lts.initial_state() };
+		std::unordered_set<std::string> seen = { lts.initial_state() };
+		for (size_t i = 0; i < queue.size(); ++i) {
+			if (!lts.HasState(*queue[i])) {
+				continue;
+			}
+			for (const auto& t : lts[*queue[i]].transitions_) {
+				if (seen.insert(t.to()).second) {
+					queue.emplace_back(&t.to());
+				}
+			}
+		}
+
+		std::unordered_set<std::string> outputs;
+		if (opts_.parts) {
+			for (const std::string* state : queue) {
+				if (!lts.HasState(*state)) {
+					continue;
+				}
+				for (const auto& t : lts[*state].transitions_) {
+					for (const auto& tasks : { &t.label().sequential, &t.label().parallel }) {
+						for (const auto& [op, input, output] : *tasks) {
+							outputs.insert(output.begin(), output.end());
+						}
+					}
+				}
+			}
+		}
+
+		PrecheckResult result;
+		for (const std::string* state : queue) {
+			if (!lts.HasState(*state)) {
+				continue;
+			}
+			const auto& transitions = lts[*state].transitions_;
+			for (size_t i = 0; i < transitions.size(); ++i) {
+				auto fail = [&](PrecheckFailure failure, const std::string& operation, const std::string& part) {
+					result = { .failure = failure, .from = *state, .to = transitions[i].to(), .transition = i, .operation = operation,
+						.part = part };
+					PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[Precheck] Recipe transition {} -> {} fails: {} {}{}",
+						result.from, result.to, ToString(failure), operation, part.empty() ? "" : " (part " + part + ")"));
+					return result;
+				};
+				for (const auto& tasks : { &transitions[i].label().sequential, &transitions[i].label().parallel }) {
+					for (const auto& [op, input, output] : *tasks) {
+						if (opts_.operations && !IsOffered(op.name())) {
+							return fail(PrecheckFailure::kUnknownOperation, op.name(), "");
+						}
+						if (opts_.channels && !IsReachable(op.name())) {
+							return fail(PrecheckFailure::kUnreachableOperation, op.name(), "");
+						}
+						if (opts_.parts) {
+							for (const auto& part : input) {
+								if (!outputs.contains(part)) {
+									return fail(PrecheckFailure::kUnproducedPart, op.name(), part);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	bool Prechecker::IsOffered(const std::string& operation) const {
+		return offered_.contains(operation);
+	}
+
+	bool Prechecker::IsReachable(const std::string& operation) const {
+		return reachable_.contains(operation);
+	}
+
+	const char* ToString(PrecheckFailure failure) {
+		switch (failure) {
+			case PrecheckFailure::kNone:
+				return "None";
+			case PrecheckFailure::kUnknownOperation:
+				return "Unknown operation";
+			case PrecheckFailure::kUnreachableOperation:
+				return "Unreachable operation";
+			case PrecheckFailure::kUnproducedPart:
+				return "Unproduced part";
+		}
+		return "Unknown";
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+
+#include "pcs/environment/environment.h"
+#include "pcs/product/recipe.h"
+
+namespace pcs {
+
+	enum class PrecheckFailure {
+		kNone,
+		kUnknownOperation,
+		kUnreachableOperation,
+		kUnproducedPart
+	};
+
+	/**
+	 * @brief The outcome of Prechecker::Check(). A failed check names the first recipe transition found at fault, its
+	 * index among the transitions of its start state, and the operation or part responsible.
+	 */
+	struct PrecheckResult {
+		PrecheckFailure failure = PrecheckFailure::kNone;
+		std::string from;
+		std::string to;
+		size_t transition = 0;
+		std::string operation;
+		std::string part;
+
+		bool passed() const {
+			return failure == PrecheckFailure::kNone;
+		}
+	};
+
+	/**
+	 * @brief Options for Prechecker, each condition can be disabled individually.
+	 * @param operations: every operation must be offered by some resource
+	 * @param channels: ...in a local state the resource can reach using its own operations and the transfers which
+	 *                  have a partner, so resources cut off from the transfer channels cannot serve the recipe
+	 * @param parts: every input part must be the output of some operation of the recipe
+	 */
+	struct PrecheckOpts {
+		bool operations = true;
+		bool channels = true;
+		bool parts = true;
+	};
+
+	/**
+	 * @brief Necessary conditions for a recipe to be realisable, which reject obviously impossible recipes without
+	 * searching the topology. The resource side is summarised once at construction; each Check() is then linear in
+	 * the size of the recipe.
+	 */
+	class Prechecker {
+	private:
+		std::unordered_set<std::string> offered_;
+		std::unordered_set<std::string> reachable_;
+		PrecheckOpts opts_;
+	public:
+		Prechecker(const Environment& machine, const PrecheckOpts& opts = {});
+
+		PrecheckResult Check(const Recipe& recipe) const;
+		bool IsOffered(const std::string& operation) const;
+		bool IsReachable(const std::string& operation) const;
+	};
+
+	const char* ToString(PrecheckFailure failure);
+
+}
\ No newline at end of file
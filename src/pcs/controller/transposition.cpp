@@ -0,0 +1,53 @@
+#include "pcs/controller/transposition.h"
+
+#include <string>
+#include <vector>
+
+#include "pcs/common/hash.h"
+
+namespace pcs {
+
+	size_t TranspositionKeyHash::operator()(const TranspositionKey& key) const {
+		return static_cast<size_t>(Mix64(Fnv1a(key.operation, HashStrings(key.state))));
+	}
+
+	/*
+	 * @brief Looks up a previous search, counting the hit or miss.
+	 * @returns The entry, or nullptr if the search has not been recorded
+	 */
+	const TranspositionEntry* TranspositionTable::Find(const TranspositionKey& key) {
+		auto it = entries_.find(key);
+		if (it == entries_.end()) {
+			++misses_;
+			return nullptr;
+		}
+		++hits_;
+		return &it->second;
+	}
+
+	void TranspositionTable::Insert(TranspositionKey&& key, TranspositionEntry&& entry) {
+		entries_.insert_or_assign(std::move(key), std::move(entry));
+	}
+
+	/*
+	 * @brief Drops all entries, which hold pointers into the topology, and resets the counters.
+	 */
+	void TranspositionTable::Clear() {
+		entries_.clear();
+		hits_ = 0;
+		misses_ = 0;
+	}
+
+	size_t TranspositionTable::size() const {
+		return entries_.size();
+	}
+
+	size_t TranspositionTable::hits() const {
+		return hits_;
+	}
+
+	size_t TranspositionTable::misses() const {
+		return misses_;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "pcs/controller/plan_list.h"
+
+namespace pcs {
+
+	/**
+	 * @brief A search for a single sequential operation: the topology state it starts from and the operation name. The
+	 * search only walks the topology, so its outcome does not depend on the parts; these are consumed and added by the
+	 * controller once the plan is applied, whether searched or replayed.
+	 */
+	struct TranspositionKey {
+		std::vector<std::string> state;
+		std::string operation;
+
+		bool operator==(const TranspositionKey& other) const = default;
+	};
+
+	struct TranspositionKeyHash {
+		size_t operator()(const TranspositionKey& key) const;
+	};
+
+	/**
+	 * @brief The outcome of a search. A realisable entry holds the plan up to and including the transition which
+	 * performs the operation, along with that transition's label and end-state; an unrealisable entry has no end-state.
+	 */
+	struct TranspositionEntry {
+		const std::vector<std::string>* end = nullptr;
+		std::pair<size_t, std::string> realised;
+		PlanList plan;
+
+		bool IsRealisable() const {
+			return end != nullptr;
+		}
+	};
+
+	class TranspositionTable {
+	private:
+		std::unordered_map<TranspositionKey, TranspositionEntry, TranspositionKeyHash> entries_;
+		size_t hits_ = 0;
+		size_t misses_ = 0;
+	public:
+		TranspositionTable() = default;
+
+		const TranspositionEntry* Find(const TranspositionKey& key);
+		void Insert(TranspositionKey&& key, TranspositionEntry&& entry);
+		void Clear();
+
+		size_t size() const;
+		size_t hits() const;
+		size_t misses() const;
+	};
+
+}
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include "pcs/environment/environment.h"
 
+#include <stdexcept>
+
 #include "pcs/topology/complete.h"
 #include "pcs/topology/incremental.h"
+#include "pcs/topology/generator.h"
+#include "pcs/topology/cache.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/topology/external.h"
+#include "pcs/topology/static.h"
+#include "pcs/topology/renumber.h"
+#include "pcs/topology/strategy.h"
+#include "pcs/common/shared_memory.h"
 #include "pcs/lts/parsers/string_string.h"
+#include "pcs/lts/minimize.h"
+#include "pcs/environment/prune.h"
 #include "pcs/common/log.h"
 
 namespace pcs {
@@ -25,6 +37,21 @@ namespace pcs {
 		return resources_;
 	}
 
+	/**
+	 * @brief The cost annotations of a resource, which are empty unless its file had any or set_costs() was used
+	 */
+	const TransitionCosts& Environment::costs(size_t resource) const {
+		static const TransitionCosts kNoCosts;
+		return (resource < costs_.size()) ? costs_[resource] : kNoCosts;
+	}
+
+	void Environment::set_costs(size_t resource, TransitionCosts costs) {
+		if (resource >= costs_.size()) {
+			costs_.resize(resource + 1);
+		}
+		costs_[resource] = std::move(costs);
+	}
+
 	const ITopology* Environment::topology() const {
 		return topology_.get();
 	}
@@ -41,14 +68,152 @@ namespace pcs {
 		return topology_->lts().NumOfStates();
 	}
 
+	/*
+	 * @brief Enables the on-disk topology cache used by Complete(), entries are keyed by the resources' content hash.
+	 */
+	void Environment::set_topology_cache(const std::filesystem::path& directory) {
+		topology_cache_.emplace(directory);
+	}
+
+	/*
+	 * @brief Computes the complete topology. With a topology cache set, a cached topology for identical resources is
+	 * mapped from disk instead, and a freshly computed topology is stored for subsequent runs.
+	 */
 	void Environment::Complete() {
+		if (topology_cache_.has_value()) {
+			topology_ = topology_cache_->Load(resources_);
+			if (topology_ != nullptr) {
+				return;
+			}
+			topology_ = std::make_unique<CompleteTopology>(resources_);
+			topology_cache_->Store(resources_, *topology_);
+			return;
+		}
 		topology_ = std::make_unique<CompleteTopology>(resources_);
 	}
 
+	/*
+	 * @brief Publishes the current topology into shared memory, so that other processes with the same resources can
+	 * AttachTopology() rather than computing their own copy.
+	 * @returns The segment, which must be kept alive whilst processes attach on Windows. Use SharedMemory::Remove()
+	 *          to release the name on POSIX systems once no more workers will attach.
+	 * @exception Throws std::logic_error if no topology has been computed, propagates std::system_error
+	 */
+	SharedMemory Environment::PublishTopology(const std::string& name) const {
+		if (topology_ == nullptr) {
+			throw std::logic_error("No topology has been computed to publish");
+		}
+		if (const auto* frozen = dynamic_cast<const FrozenTopology*>(topology_.get()); frozen != nullptr) {
+			return frozen->Publish(name);
+		}
+		return FrozenTopology(topology_->lts(), ContentHash(resources_)).Publish(name);
+	}
+
+	/*
+	 * @brief Replaces the topology with a read-only view of a topology published by another process.
+	 * @exception Throws std::runtime_error if the published topology was computed from different resources,
+	 *            propagates std::system_error if nothing is published under the name
+	 */
+	void Environment::AttachTopology(const std::string& name) {
+		std::unique_ptr<FrozenTopology> topology = FrozenTopology::Attach(name);
+		if (topology->content_hash() != ContentHash(resources_)) {
+			throw std::runtime_error("Published topology " + name + " was computed from different resources");
+		}
+		topology_ = std::move(topology);
+	}
+
+	/*
+	 * @brief Replaces the topology with a frozen copy whose states are laid out in the given order, freezing the
+	 * current topology first if needed.
+	 * @exception Throws std::logic_error if no topology has been computed
+	 */
+	void Environment::RenumberTopology(StateOrder order) {
+		if (topology_ == nullptr) {
+			throw std::logic_error("No topology has been computed to renumber");
+		}
+		if (const auto* frozen = dynamic_cast<const FrozenTopology*>(topology_.get()); frozen != nullptr) {
+			topology_ = Renumber(*frozen, order);
+			return;
+		}
+		topology_ = Renumber(FrozenTopology(topology_->lts(), ContentHash(resources_)), order);
+	}
+
+	/*
+	 * @brief Replaces each resource by its bisimulation quotient, which shrinks the topology by the product of the
+	 * per-resource reductions. Call before computing the topology; a topology computed beforehand is discarded.
+	 */
+	std::vector<MinimizeStats> Environment::MinimizeResources(const MinimizeOpts& opts) {
+		topology_.reset();
+		std::vector<MinimizeStats> stats(resources_.size());
+		for (size_t i = 0; i < resources_.size(); ++i) {
+			resources_[i] = Minimize(resources_[i], opts, &stats[i]);
+			PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[Minimize] Resource {}: {} -> {} states, {} -> {} transitions", i,
+				stats[i].states_before, stats[i].states_after, stats[i].transitions_before, stats[i].transitions_after));
+		}
+		return stats;
+	}
+
+	/*
+	 * @brief Removes dead transfer channels, unreachable local states and silent self-loops from the resources, see
+	 * pcs::PruneResources(). Call before computing the topology; a topology computed beforehand is discarded.
+	 */
+	PruneStats Environment::PruneResources(const PruneOpts& opts) {
+		topology_.reset();
+		PruneStats stats = pcs::PruneResources(resources_, opts);
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[Prune] Removed {} dead transfers, {} unreachable states and {} self-loops in {} rounds",
+			stats.dead_transfers, stats.unreachable_states, stats.self_loops, stats.rounds));
+		return stats;
+	}
+
 	void Environment::Incremental() {
 		topology_ = std::make_unique<IncrementalTopology>(resources_);
 	}
 
+	void Environment::Generator() {
+		topology_ = std::make_unique<GeneratorTopology>(resources_);
+	}
+
+	/*
+	 * @brief Computes the topology with fixed size integer keys specialised on the number of resources, see MakeStaticTopology().
+	 */
+	void Environment::Static(bool incremental) {
+		topology_ = MakeStaticTopology(resources_, incremental);
+	}
+
+	/*
+	 * @brief Explores the complete topology on disk with a bounded amount of memory and maps the result. With a
+	 * topology cache set the result is written straight into the cache, otherwise into the scratch directory.
+	 * @exception Propagates std::ios_base::failure
+	 */
+	ExternalStats Environment::External(const ExternalOpts& opts) {
+		uint64_t content_hash = ContentHash(resources_);
+		std::filesystem::path output = topology_cache_.has_value() ? topology_cache_->PathFor(content_hash)
+			: opts.directory / fmt::format("topology-{:016x}.pcst", content_hash);
+		ExternalStats stats = ExploreExternal(resources_, output, opts, content_hash);
+		topology_ = FrozenTopology::Load(output);
+		return stats;
+	}
+
+	/*
+	 * @brief Computes the topology with the strategy ChooseStrategy() picks for these resources and recipe.
+	 */
+	StrategyStats Environment::Adaptive(const Recipe& recipe, const StrategyOpts& opts) {
+		StrategyStats stats = ChooseStrategy(resources_, recipe, opts);
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[Adaptive Topology] {}: {}", ToString(stats.strategy), stats.reason));
+		switch (stats.strategy) {
+			case TopologyStrategy::kComplete:
+				Complete();
+				break;
+			case TopologyStrategy::kIncremental:
+				Incremental();
+				break;
+			case TopologyStrategy::kGenerator:
+				Generator();
+				break;
+		}
+		return stats;
+	}
+
 	/*
 	 * @brief Loads a LTS file and adds it to the machine, and handles recomputing the topology
 	 * @param filepath: relative path to the LTS file to parse and adds it
@@ -57,16 +222,20 @@ namespace pcs {
 	 */
 	void Environment::AddResource(const std::filesystem::path& filepath, bool is_json) {
 		LTS<std::string> lts;
+		TransitionCosts costs;
 		try {
 			if (is_json) {
-				ReadFromJsonFile(lts, filepath);
+				ReadFromJsonFile(lts, filepath, &costs);
 			} else {
-				ReadFromFile(lts, filepath);
+				ReadFromFile(lts, filepath, &costs);
 			}
 		} catch (const std::ifstream::failure& e) {
 			throw;
 		}
 		AddResource(std::move(lts));
+		if (!costs.IsEmpty()) {
+			set_costs(resources_.size() - 1, std::move(costs));
+		}
 	}
 
 	/*
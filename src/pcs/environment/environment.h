@@ -4,35 +4,61 @@
 #include <span>
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 #include <boost/container_hash/hash.hpp>
 
 #include "pcs/lts/lts.h"
+#include "pcs/lts/minimize.h"
+#include "pcs/environment/prune.h"
 #include "pcs/product/recipe.h"
 #include "pcs/topology/topology.h"
 #include "pcs/topology/complete.h"
 #include "pcs/topology/incremental.h"
+#include "pcs/topology/generator.h"
+#include "pcs/topology/cache.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/topology/external.h"
+#include "pcs/topology/renumber.h"
+#include "pcs/topology/strategy.h"
+#include "pcs/lts/costs.h"
+#include "pcs/common/shared_memory.h"
 
 namespace pcs {
 
 	class Environment {
 	private:
 		std::vector<LTS<std::string, std::string>> resources_;
+		std::vector<TransitionCosts> costs_;
 		std::unique_ptr<ITopology> topology_;
+		std::optional<TopologyCache> topology_cache_;
 	public:
 		Environment() = default;
 		Environment(const std::span<LTS<std::string, std::string>>& resources, bool compute_topology);
 		Environment(std::vector<LTS<std::string, std::string>>&& resources, bool compute_topology);
 
 		const std::vector<LTS<std::string, std::string>>& resources() const;
+		const TransitionCosts& costs(size_t resource) const;
+		void set_costs(size_t resource, TransitionCosts costs);
 		const ITopology* topology() const;
 	    ITopology* topology();
 
 		size_t NumOfResources() const;
 		size_t NumOfTopologyStates() const;
 
+		void set_topology_cache(const std::filesystem::path& directory);
+		SharedMemory PublishTopology(const std::string& name) const;
+		void AttachTopology(const std::string& name);
+		void RenumberTopology(StateOrder order);
+		std::vector<MinimizeStats> MinimizeResources(const MinimizeOpts& opts = {});
+		PruneStats PruneResources(const PruneOpts& opts = {});
+
 		void Complete();
 		void Incremental();
+		void Generator();
+		void Static(bool incremental);
+		ExternalStats External(const ExternalOpts& opts);
+		StrategyStats Adaptive(const Recipe& recipe, const StrategyOpts& opts = {});
 
 		/* @Todo */
 		void ComputeTopology(std::initializer_list<size_t> resources);
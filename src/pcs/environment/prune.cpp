@@ -0,0 +1,143 @@
+#include "pcs/environment/prune.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+#include "pcs/operation/transfer.h"
+#include "pcs/operation/parsers/label.h"
+
+namespace pcs {
+
+	/**
+	 * @brief Whether the transfer label takes part in any synchronisation: either another resource offers a label
+	 * containing its inverse, or it contains the inverse of another resource's transfer (see MatchingTransferPartner).
+	 * @param labels: the labels of each resource
+	 */
+	bool IsLiveTransfer(const std::vector<std::set<std::string>>& labels, size_t resource, const std::string& label) {
+		std::string inverse = StringToTransfer(label)->Inverse().name();
+		for (size_t i = 0; i < labels.size(); ++i) {
+			if (i == resource) {
+				continue;
+			}
+			for (const auto& other : labels[i]) {
+				if (other.find(inverse) != std::string::npos) {
+					return true;
+				}
+				if (IsTransferLabel(other) && label.find(StringToTransfer(other)->Inverse().name()) != std::string::npos) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	static size_t RemoveDeadTransfers(std::vector<LTS<std::string, std::string>>& resources) {
+		std::vector<std::set<std::string>> labels(resources.size());
+		for (size_t r = 0; r < resources.size(); ++r) {
+			for (const auto& [name, state] : resources[r].states()) {
+				for (const auto& t : state.transitions_) {
+					labels[r].insert(t.label());
+				}
+			}
+		}
+		size_t removed = 0;
+		for (size_t r = 0; r < resources.size(); ++r) {
+			std::set<std::string> dead;
+			for (const auto& label : labels[r]) {
+				if (IsTransferLabel(label) && !IsLiveTransfer(labels, r, label)) {
+					dead.insert(label);
+				}
+			}
+			if (dead.empty()) {
+				continue;
+			}
+			std::vector<std::string> names;
+			for (const auto& [name, state] : resources[r].states()) {
+				names.emplace_back(name);
+			}
+			for (const auto& name : names) {
+				removed += std::erase_if(resources[r][name].transitions_, [&](const auto& t) { return dead.contains(t.label()); });
+			}
+		}
+		return removed;
+	}
+
+	static size_t RemoveUnreachableStates(LTS<std::string, std::string>& resource) {
+		if (!resource.HasState(resource.initial_state())) {
+			return 0;
+		}
+		std::set<std::string> reached = { resource.initial_state() };
+		std::vector<const std::string*> stack = { &resource.initial_state() };
+		while (!stack.empty()) {
+			const std::string* state = stack.back();
+			stack.pop_back();
+			for (const auto& t : resource[*state].transitions_) {
+				if (reached.insert(t.to()).second) {
+					stack.emplace_back(&t.to());
+				}
+			}
+		}
+		std::vector<std::string> unreachable;
+		for (const auto& [name, state] : resource.states()) {
+			if (!reached.contains(name)) {
+				unreachable.emplace_back(name);
+			}
+		}
+		for (const auto& name : unreachable) {
+			resource.EraseShallow(name);
+		}
+		return unreachable.size();
+	}
+
+	static size_t RemoveSelfLoops(LTS<std::string, std::string>& resource, const std::string& silent) {
+		size_t removed = 0;
+		std::vector<std::string> names;
+		for (const auto& [name, state] : resource.states()) {
+			names.emplace_back(name);
+		}
+		for (const auto& name : names) {
+			removed += std::erase_if(resource[name].transitions_, [&](const auto& t) { return t.label() == silent && t.to() == name; });
+		}
+		return removed;
+	}
+
+	/**
+	 * @brief Removes the parts of the resources which cannot contribute to a plan, before any topology is computed.
+	 * Removing dead transfers can make states unreachable and vice versa, so the passes are repeated until nothing
+	 * changes. The remaining transitions keep their order, so with silent_self_loops disabled the reachable topology
+	 * is unchanged.
+	 */
+	PruneStats PruneResources(std::vector<LTS<std::string, std::string>>& resources, const PruneOpts& opts) {
+		PruneStats stats;
+		if (opts.silent_self_loops) {
+			for (auto& resource : resources) {
+				stats.self_loops += RemoveSelfLoops(resource, opts.silent);
+			}
+		}
+		while (true) {
+			++stats.rounds;
+			size_t removed = 0;
+			if (opts.dead_transfers) {
+				size_t transfers = RemoveDeadTransfers(resources);
+				stats.dead_transfers += transfers;
+				removed += transfers;
+			}
+			if (opts.unreachable_states) {
+				for (auto& resource : resources) {
+					size_t states = RemoveUnreachableStates(resource);
+					stats.unreachable_states += states;
+					removed += states;
+				}
+			}
+			if (removed == 0) {
+				break;
+			}
+		}
+		return stats;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+
+namespace pcs {
+
+	/**
+	 * @brief Options for PruneResources(), each pass can be disabled individually.
+	 * @param dead_transfers: remove transfers which no transition of another resource can synchronise with
+	 * @param unreachable_states: remove local states which cannot be reached from the resource's initial state
+	 * @param silent_self_loops: remove self-loops labelled `silent`, these only add topology edges which plans never use
+	 */
+	struct PruneOpts {
+		bool dead_transfers = true;
+		bool unreachable_states = true;
+		bool silent_self_loops = true;
+		std::string silent = "nop";
+	};
+
+	struct PruneStats {
+		size_t dead_transfers = 0;
+		size_t unreachable_states = 0;
+		size_t self_loops = 0;
+		size_t rounds = 0;
+	};
+
+	PruneStats PruneResources(std::vector<LTS<std::string, std::string>>& resources, const PruneOpts& opts = {});
+	bool IsLiveTransfer(const std::vector<std::set<std::string>>& labels, size_t resource, const std::string& label);
+
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "pcs/environment/transfer_graph.h"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+#include "pcs/operation/transfer.h"
+#include "pcs/operation/parsers/label.h"
+
+namespace pcs {
+
+	/*
+	 * @brief Finds the root of a union-find set, halving the path on the way
+	 */
+	static size_t FindRoot(std::vector<size_t>& parents, size_t i) {
+		while (parents[i] != i) {
+			parents[i] = parents[parents[i]];
+			i = parents[i];
+		}
+		return i;
+	}
+
+	TransferGraph::TransferGraph(const std::vector<LTS<std::string, std::string>>& resources)
+		: num_of_resources_(resources.size()), outgoing_(resources.size()) {
+		const size_t n = num_of_resources_;
+		std::vector<std::set<std::string>> labels(n);
+		for (size_t r = 0; r < n; ++r) {
+			for (const auto& [name, state] : resources[r].states()) {
+				for (const auto& t : state.transitions_) {
+					labels[r].insert(t.label());
+				}
+			}
+		}
+
+		// Either side of a transfer may initiate it, the part always moves from the out side to the in side
+		std::set<std::tuple<size_t, size_t, std::string, std::string>> seen;
+		for (size_t i = 0; i < n; ++i) {
+			for (const auto& label : labels[i]) {
+				if (!IsTransferLabel(label)) {
+					continue;
+				}
+				TransferOperation transfer = *StringToTransfer(label);
+				std::string inverse = transfer.Inverse().name();
+				for (size_t j = 0; j < n; ++j) {
+					if (j == i) {
+						continue;
+					}
+					for (const auto& other : labels[j]) {
+						if (other.find(inverse) == std::string::npos) {
+							continue;
+						}
+						auto channel = transfer.IsOut() ? std::make_tuple(i, j, label, other) : std::make_tuple(j, i, other, label);
+						if (seen.insert(channel).second) {
+							AddChannel(std::get<0>(channel), std::get<1>(channel), std::get<2>(channel), std::get<3>(channel), resources);
+						}
+					}
+				}
+			}
+		}
+
+		// Breadth first search from every resource
+		distances_.assign(n * n, kNoRoute);
+		next_hops_.assign(n * n, kNoRoute);
+		std::vector<size_t> queue;
+		for (size_t source = 0; source < n; ++source) {
+			queue.assign(1, source);
+			distances_[source * n + source] = 0;
+			for (size_t q = 0; q < queue.size(); ++q) {
+				size_t current = queue[q];
+				for (size_t c : outgoing_[current]) {
+					size_t to = channels_[c].to;
+					if (distances_[source * n + to] != kNoRoute) {
+						continue;
+					}
+					distances_[source * n + to] = distances_[source * n + current] + 1;
+					next_hops_[source * n + to] = (current == source) ? to : next_hops_[source * n + current];
+					queue.emplace_back(to);
+				}
+			}
+		}
+
+		std::vector<size_t> parents(n);
+		std::iota(parents.begin(), parents.end(), 0);
+		for (const auto& channel : channels_) {
+			parents[FindRoot(parents, channel.from)] = FindRoot(parents, channel.to);
+		}
+		std::vector<size_t> ids(n, kNoRoute);
+		components_.resize(n);
+		for (size_t r = 0; r < n; ++r) {
+			size_t root = FindRoot(parents, r);
+			if (ids[root] == kNoRoute) {
+				ids[root] = num_of_components_++;
+			}
+			components_[r] = ids[root];
+		}
+	}
+
+	void TransferGraph::AddChannel(size_t from, size_t to, const std::string& out_label, const std::string& in_label,
+		const std::vector<LTS<std::string, std::string>>& resources) {
+		TransferChannel& channel = channels_.emplace_back(from, to, out_label, in_label);
+		for (const auto& [name, state] : resources[from].states()) {
+			if (std::any_of(state.transitions_.begin(), state.transitions_.end(), [&](const auto& t) { return t.label() == out_label; })) {
+				channel.from_states.emplace_back(name);
+			}
+		}
+		for (const auto& [name, state] : resources[to].states()) {
+			if (std::any_of(state.transitions_.begin(), state.transitions_.end(), [&](const auto& t) { return t.label() == in_label; })) {
+				channel.to_states.emplace_back(name);
+			}
+		}
+		std::sort(channel.from_states.begin(), channel.from_states.end());
+		std::sort(channel.to_states.begin(), channel.to_states.end());
+		outgoing_[from].emplace_back(channels_.size() - 1);
+	}
+
+	size_t TransferGraph::NumOfResources() const {
+		return num_of_resources_;
+	}
+
+	const std::vector<TransferChannel>& TransferGraph::channels() const {
+		return channels_;
+	}
+
+	/**
+	 * @brief Indices into channels() of the channels along which the resource passes parts on
+	 */
+	const std::vector<size_t>& TransferGraph::Outgoing(size_t resource) const {
+		return outgoing_.at(resource);
+	}
+
+	/**
+	 * @brief The fewest transfers to pass a part from one resource to another, or kNoRoute
+	 */
+	size_t TransferGraph::Distance(size_t from, size_t to) const {
+		return distances_.at(from * num_of_resources_ + to);
+	}
+
+	/**
+	 * @brief The resources a part passes through on a shortest route, starting with from and ending with to,
+	 * or empty if there is no route
+	 */
+	std::vector<size_t> TransferGraph::Route(size_t from, size_t to) const {
+		if (Distance(from, to) == kNoRoute) {
+			return {};
+		}
+		std::vector<size_t> route = { from };
+		while (route.back() != to) {
+			route.emplace_back(next_hops_[route.back() * num_of_resources_ + to]);
+		}
+		return route;
+	}
+
+	size_t TransferGraph::Component(size_t resource) const {
+		return components_.at(resource);
+	}
+
+	size_t TransferGraph::NumOfComponents() const {
+		return num_of_components_;
+	}
+
+	/**
+	 * @brief Whether the resources are connected by channels in either direction, so the transfers of one can
+	 * eventually affect the other
+	 */
+	bool TransferGraph::IsConnected(size_t a, size_t b) const {
+		return Component(a) == Component(b);
+	}
+
+}
\ No newline at end of file
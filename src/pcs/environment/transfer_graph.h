@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+
+namespace pcs {
+
+	/**
+	 * @brief A channel along which resource `from` can pass parts to resource `to`: a transition labelled `out_label`
+	 * of `from` synchronising with one labelled `in_label` of `to`, along with the local states offering each.
+	 */
+	struct TransferChannel {
+		size_t from;
+		size_t to;
+		std::string out_label;
+		std::string in_label;
+		std::vector<std::string> from_states;
+		std::vector<std::string> to_states;
+	};
+
+	/**
+	 * @brief Which resources can pass parts to which, from the transfer labels of the resource LTSs. Labels are matched
+	 * as by MatchingTransferPartner(), disregarding the local states the resources are in. Precomputes the fewest
+	 * transfers between every pair of resources, with the first hop of such a route, and the components of resources
+	 * connected by channels in either direction.
+	 */
+	class TransferGraph {
+	public:
+		static constexpr size_t kNoRoute = SIZE_MAX;
+	private:
+		size_t num_of_resources_;
+		std::vector<TransferChannel> channels_;
+		std::vector<std::vector<size_t>> outgoing_;
+		std::vector<size_t> distances_;
+		std::vector<size_t> next_hops_;
+		std::vector<size_t> components_;
+		size_t num_of_components_ = 0;
+	public:
+		TransferGraph(const std::vector<LTS<std::string, std::string>>& resources);
+
+		size_t NumOfResources() const;
+		const std::vector<TransferChannel>& channels() const;
+		const std::vector<size_t>& Outgoing(size_t resource) const;
+
+		size_t Distance(size_t from, size_t to) const;
+		std::vector<size_t> Route(size_t from, size_t to) const;
+
+		size_t Component(size_t resource) const;
+		size_t NumOfComponents() const;
+		bool IsConnected(size_t a, size_t b) const;
+	private:
+		void AddChannel(size_t from, size_t to, const std::string& out_label, const std::string& in_label,
+			const std::vector<LTS<std::string, std::string>>& resources);
+	};
+
+}
\ No newline at end of file
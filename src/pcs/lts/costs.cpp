@@ -0,0 +1,34 @@
+#include "pcs/lts/costs.h"
+
+#include <string>
+#include <stdexcept>
+
+namespace pcs {
+
+	/*
+	 * @exception Throws std::invalid_argument for negative costs, which shortest path searches cannot handle
+	 */
+	void TransitionCosts::Add(const std::string& from, const std::string& label, const std::string& to, double cost) {
+		if (cost < 0.0) {
+			throw std::invalid_argument("Negative cost for transition " + from + ' ' + label + ' ' + to);
+		}
+		costs_.insert_or_assign(std::make_tuple(from, label, to), cost);
+	}
+
+	double TransitionCosts::Cost(const std::string& from, const std::string& label, const std::string& to) const {
+		if (costs_.empty()) {
+			return kDefaultCost;
+		}
+		auto it = costs_.find(std::make_tuple(from, label, to));
+		return (it == costs_.end()) ? kDefaultCost : it->second;
+	}
+
+	bool TransitionCosts::IsEmpty() const {
+		return costs_.empty();
+	}
+
+	size_t TransitionCosts::size() const {
+		return costs_.size();
+	}
+
+}
\ No newline at end of file
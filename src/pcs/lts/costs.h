@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+namespace pcs {
+
+	/**
+	 * @brief Optional cost or duration annotations of a resource's transitions, keyed by (start state, label, end state).
+	 * Transitions without an annotation cost kDefaultCost, so an unannotated resource costs one per step.
+	 */
+	class TransitionCosts {
+	public:
+		static constexpr double kDefaultCost = 1.0;
+	private:
+		std::unordered_map<std::tuple<std::string, std::string, std::string>, double,
+			boost::hash<std::tuple<std::string, std::string, std::string>>> costs_;
+	public:
+		TransitionCosts() = default;
+
+		void Add(const std::string& from, const std::string& label, const std::string& to, double cost);
+		double Cost(const std::string& from, const std::string& label, const std::string& to) const;
+
+		bool IsEmpty() const;
+		size_t size() const;
+	};
+
+}
\ No newline at end of file
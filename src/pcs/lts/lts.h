@@ -28,7 +28,7 @@ namespace pcs {
 		LTS() = default;
 
 		LTS(const KeyT& initial_state, bool create_initial=true) {
-			SetInitialState(initial_state, create_initial);
+			set_initial_state(initial_state, create_initial);
 		}
 
 		~LTS() = default;
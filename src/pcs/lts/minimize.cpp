@@ -0,0 +1,145 @@
+#include "pcs/lts/minimize.h"
+
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <utility>
+#include <unordered_map>
+
+namespace pcs {
+
+	using Adjacency = std::vector<std::vector<std::pair<uint32_t, uint32_t>>>;
+	using Signature = std::vector<std::pair<uint32_t, uint32_t>>;
+
+	static constexpr uint32_t kNoLabel = UINT32_MAX;
+
+	/*
+	 * @brief The states reachable from s by silent steps which stay within the block of s, in breadth first order starting with s.
+	 */
+	static std::vector<uint32_t> InertClosure(const Adjacency& out, const std::vector<uint32_t>& block, uint32_t silent, uint32_t s) {
+		std::vector<uint32_t> closure = { s };
+		std::set<uint32_t> seen = { s };
+		for (size_t i = 0; i < closure.size(); ++i) {
+			for (const auto& [label, to] : out[closure[i]]) {
+				if (label == silent && block[to] == block[s] && seen.insert(to).second) {
+					closure.emplace_back(to);
+				}
+			}
+		}
+		return closure;
+	}
+
+	/*
+	 * @brief The (label, target block) pairs of s. For branching bisimulation these are the pairs reachable after inert
+	 * silent steps, excluding the inert steps themselves.
+	 */
+	static Signature SignatureOf(const Adjacency& out, const std::vector<uint32_t>& block, uint32_t silent, uint32_t s) {
+		Signature signature;
+		std::vector<uint32_t> sources = (silent == kNoLabel) ? std::vector<uint32_t>{ s } : InertClosure(out, block, silent, s);
+		for (uint32_t q : sources) {
+			for (const auto& [label, to] : out[q]) {
+				if (label == silent && block[to] == block[s]) {
+					continue;
+				}
+				signature.emplace_back(label, block[to]);
+			}
+		}
+		std::sort(signature.begin(), signature.end());
+		signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+		return signature;
+	}
+
+	/**
+	 * @brief Computes the quotient of a resource modulo strong or branching bisimulation by signature based partition
+	 * refinement. Each class of equivalent states is named after one of its members: the initial state for its own class,
+	 * otherwise the lexicographically smallest name. The quotient keeps the transition order of that member, so transfer
+	 * matching and plan search see the same first choices as on the original resource.
+	 */
+	LTS<std::string, std::string> Minimize(const LTS<std::string, std::string>& lts, const MinimizeOpts& opts, MinimizeStats* stats) {
+		std::vector<std::string> names;
+		for (const auto& [name, state] : lts.states()) {
+			names.emplace_back(name);
+		}
+		std::sort(names.begin(), names.end());
+		std::unordered_map<std::string, uint32_t> ids;
+		for (uint32_t i = 0; i < names.size(); ++i) {
+			ids.emplace(names[i], i);
+		}
+
+		std::vector<std::string> labels;
+		std::unordered_map<std::string, uint32_t> label_ids;
+		Adjacency out(names.size());
+		for (uint32_t s = 0; s < names.size(); ++s) {
+			for (const auto& t : lts[names[s]].transitions_) {
+				auto [it, inserted] = label_ids.try_emplace(t.label(), static_cast<uint32_t>(labels.size()));
+				if (inserted) {
+					labels.emplace_back(t.label());
+				}
+				out[s].emplace_back(it->second, ids.at(t.to()));
+			}
+		}
+		uint32_t silent = kNoLabel;
+		if (opts.branching && label_ids.contains(opts.silent)) {
+			silent = label_ids.at(opts.silent);
+		}
+
+		// Split blocks by signature until stable, blocks are numbered in order of their first (smallest) state
+		std::vector<uint32_t> block(names.size(), 0);
+		size_t num_blocks = names.empty() ? 0 : 1;
+		size_t rounds = 0;
+		while (true) {
+			++rounds;
+			std::map<std::pair<uint32_t, Signature>, uint32_t> refined;
+			std::vector<uint32_t> next(names.size());
+			for (uint32_t s = 0; s < names.size(); ++s) {
+				auto key = std::make_pair(block[s], SignatureOf(out, block, silent, s));
+				next[s] = refined.try_emplace(std::move(key), static_cast<uint32_t>(refined.size())).first->second;
+			}
+			if (refined.size() == num_blocks) {
+				break;
+			}
+			num_blocks = refined.size();
+			block = std::move(next);
+		}
+
+		std::vector<uint32_t> representative(num_blocks, kNoLabel);
+		if (ids.contains(lts.initial_state())) {
+			uint32_t initial = ids.at(lts.initial_state());
+			representative[block[initial]] = initial;
+		}
+		for (uint32_t s = 0; s < names.size(); ++s) {
+			if (representative[block[s]] == kNoLabel) {
+				representative[block[s]] = s;
+			}
+		}
+
+		LTS<std::string, std::string> quotient;
+		quotient.set_initial_state(lts.initial_state(), lts.HasState(lts.initial_state()));
+		for (uint32_t b = 0; b < num_blocks; ++b) {
+			uint32_t r = representative[b];
+			quotient.AddState(names[r]);
+			std::set<std::pair<uint32_t, uint32_t>> added;
+			std::vector<uint32_t> sources = (silent == kNoLabel) ? std::vector<uint32_t>{ r } : InertClosure(out, block, silent, r);
+			for (uint32_t q : sources) {
+				for (const auto& [label, to] : out[q]) {
+					if (label == silent && block[to] == b) {
+						continue;
+					}
+					if (added.emplace(label, block[to]).second) {
+						quotient.AddTransition(names[r], labels[label], names[representative[block[to]]]);
+					}
+				}
+			}
+		}
+
+		if (stats != nullptr) {
+			*stats = { .states_before = lts.NumOfStates(), .states_after = quotient.NumOfStates(),
+				.transitions_before = lts.NumOfTransitions(), .transitions_after = quotient.NumOfTransitions(), .rounds = rounds };
+		}
+		return quotient;
+	}
+
+}
\ No newline at end of file
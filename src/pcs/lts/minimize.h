@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "pcs/lts/lts.h"
+
+namespace pcs {
+
+	/**
+	 * @brief Options for Minimize().
+	 * @param branching: minimise modulo branching bisimulation rather than strong bisimulation, treating `silent` as the
+	 *                   unobservable action. Silent steps between equivalent states are dropped from the quotient.
+	 * @param silent: the label of the silent action
+	 */
+	struct MinimizeOpts {
+		bool branching = false;
+		std::string silent = "nop";
+	};
+
+	struct MinimizeStats {
+		size_t states_before = 0;
+		size_t states_after = 0;
+		size_t transitions_before = 0;
+		size_t transitions_after = 0;
+		size_t rounds = 0;
+	};
+
+	LTS<std::string, std::string> Minimize(const LTS<std::string, std::string>& lts, const MinimizeOpts& opts = {},
+		MinimizeStats* stats = nullptr);
+
+}
\ No newline at end of file
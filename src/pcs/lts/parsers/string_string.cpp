@@ -18,13 +18,14 @@ namespace pcs {
 	 *
 	 * The first line represents the initial state, and proceeding lines represent a
 	 * transition, composed of the form:
-	 *		StartState Action EndState
+	 *		StartState Action EndState [Cost]
 	 *
 	 * @param lts: Labelled Transition System to parse into
 	 * @param filepath: path to the file containing a LTS, examples contained within the data folder.
-	 * @exception Propagates std::ifstream::failure
+	 * @param costs: receives the optional cost/duration annotations, which are otherwise ignored
+	 * @exception Propagates std::ifstream::failure, std::invalid_argument for malformed costs
 	 */
-	void ReadFromFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath) {
+	void ReadFromFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath, TransitionCosts* costs) {
 		std::string line;
 		bool first_line = true;
 		try {
@@ -36,12 +37,16 @@ namespace pcs {
 					first_line = false;
 					continue;
 				}
-				std::string start_state, label, end_state;
+				std::string start_state, label, end_state, cost;
 				std::istringstream ss(line);
 				std::getline(ss, start_state, ' ');
 				std::getline(ss, label, ' ');
-				std::getline(ss, end_state);
+				std::getline(ss, end_state, ' ');
+				std::getline(ss, cost);
 				lts.AddTransition(start_state, label, end_state);
+				if (costs != nullptr && !cost.empty()) {
+					costs->Add(start_state, label, end_state, std::stod(cost));
+				}
 			}
 		} catch (std::ifstream::failure& e) {
 			throw;
@@ -79,13 +84,14 @@ namespace pcs {
 	 * @brief ReadFromFile will parse a JSON input file into an instance of the LTS<Key = string, Transition = string> class.
 	 *
 	 * The expected form consists of: initialState as a string, and an array of transitions
-	 * consisting of startState, label, and endState strings.
+	 * consisting of startState, label, and endState strings, and an optional cost number.
 	 *
 	 * @param lts: Labelled Transition System to parse into
 	 * @param filepath: path to the file containing a LTS, examples contained within the data folder.
+	 * @param costs: receives the optional cost/duration annotations, which are otherwise ignored
 	 * @exception Propagates std::ifstream::failure
 	 */
-	void ReadFromJsonFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath) {
+	void ReadFromJsonFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath, TransitionCosts* costs) {
 		nlohmann::json j;
 		try {
 			std::ifstream stream(filepath);
@@ -93,18 +99,23 @@ namespace pcs {
 		} catch (std::ifstream::failure& e) {
 			throw;
 		}
-		ParseJson(lts, j);
+		ParseJson(lts, j, costs);
 	}
 
 	/*
 	 * @brief ParseJson will read data into a LTS instance from a JSON object instance.
 	 * @param lts: Labelled Transition System to parse into
-	 * @param j: json object containing the "initialState" and "transitions" array of "startState", "label" & "endState"
+	 * @param j: json object containing the "initialState" and "transitions" array of "startState", "label" & "endState",
+	 *           and optionally "cost"
+	 * @param costs: receives the optional cost/duration annotations, which are otherwise ignored
 	 */
-	void ParseJson(LTS<std::string, std::string>& lts, const nlohmann::json& j) {
+	void ParseJson(LTS<std::string, std::string>& lts, const nlohmann::json& j, TransitionCosts* costs) {
 		lts.set_initial_state(j["initialState"], true);
 		for (const auto& t : j["transitions"]) {
 			lts.AddTransition(t["startState"], t["label"], t["endState"], true);
+			if (costs != nullptr && t.contains("cost")) {
+				costs->Add(t["startState"], t["label"], t["endState"], t["cost"].get<double>());
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pcs/lts/lts.h"
+#include "pcs/lts/costs.h"
 
 #include <string>
 #include <vector>
@@ -10,9 +11,9 @@
 
 namespace pcs {
 
-	void ReadFromFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath);
+	void ReadFromFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath, TransitionCosts* costs = nullptr);
 	void ReadFromFile(LTS<std::vector<std::string>, std::string>& lts, const std::filesystem::path& filepath);
 
-	void ReadFromJsonFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath);
-	void ParseJson(LTS<std::string, std::string>& lts, const nlohmann::json& j);
+	void ReadFromJsonFile(LTS<std::string, std::string>& lts, const std::filesystem::path& filepath, TransitionCosts* costs = nullptr);
+	void ParseJson(LTS<std::string, std::string>& lts, const nlohmann::json& j, TransitionCosts* costs = nullptr);
 }
\ No newline at end of file
@@ -18,9 +18,10 @@ namespace pcs {
 	 *
 	 * @param lts: Labelled Transition System to parse into
 	 * @param filepath: path to the file containing a LTS, examples contained within the data folder.
+	 * @param parts: if given, interns the names of every part the recipe mentions
 	 * @exception Propagates std::ifstream::failure
 	 */
-	void ReadFromJsonFile(LTS<std::string, CompositeOperation>& lts, const std::filesystem::path& filepath) {
+	void ReadFromJsonFile(LTS<std::string, CompositeOperation>& lts, const std::filesystem::path& filepath, PartNames* parts) {
 		nlohmann::json j;
 		try {
 			std::ifstream stream(filepath);
@@ -29,15 +30,23 @@ namespace pcs {
 		catch (std::ifstream::failure& e) {
 			throw;
 		}
-		ParseJson(lts, j);
+		ParseJson(lts, j, parts);
 	}
 
 	/**
 	 * @brief ParseJson will read data into a LTS<KeyType = String, TransitionType = CompositeOperation> instance from a JSON object instance.
 	 * @param lts: Labelled Transition System to parse into
 	 * @param j: json object containing the correct object layout as previously defined
+	 * @param parts: if given, interns the part names in order of appearance
 	 */
-	void ParseJson(LTS<std::string, CompositeOperation>& lts, const nlohmann::json& j) {
+	void ParseJson(LTS<std::string, CompositeOperation>& lts, const nlohmann::json& j, PartNames* parts) {
+		auto intern = [parts](const std::vector<std::string>& names) {
+			if (parts != nullptr) {
+				for (const auto& name : names) {
+					parts->Intern(name);
+				}
+			}
+		};
 		lts.set_initial_state(j["initialState"], true);
 		for (const auto& t : j["transitions"]) {
 			CompositeOperation co;
@@ -46,6 +55,7 @@ namespace pcs {
 				for (const auto& g : t["label"]["guard"]["input"]) {
 					co.guard.second.emplace_back(g);
 				}
+				intern(co.guard.second);
 			}
 			for (const auto& seq_op : t["label"]["sequential"]) {
 				Observable o;
@@ -58,6 +68,8 @@ namespace pcs {
 				for (const auto& out : seq_op["output"]) {
 					output.emplace_back(out);
 				}
+				intern(input);
+				intern(output);
 				co.sequential.emplace_back(std::move(o), input, output);
 			}
 			for (const auto& par_op : t["label"]["parallel"]) {
@@ -71,6 +83,8 @@ namespace pcs {
 				for (const auto& out : par_op["output"]) {
 					output.emplace_back(out);
 				}
+				intern(input);
+				intern(output);
 				co.parallel.emplace_back(std::move(o), input, output);
 			}
 			lts.AddTransition(t["startState"], std::move(co), t["endState"], true);
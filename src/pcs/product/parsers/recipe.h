@@ -4,8 +4,9 @@
 
 #include "pcs/lts/lts.h"
 #include "pcs/operation/composite.h"
+#include "pcs/product/part_names.h"
 
 namespace pcs {
-	void ReadFromJsonFile(LTS<std::string, CompositeOperation>& lts, const std::filesystem::path& filepath);
-	void ParseJson(LTS<std::string, CompositeOperation>& lts, const nlohmann::json& j);
+	void ReadFromJsonFile(LTS<std::string, CompositeOperation>& lts, const std::filesystem::path& filepath, PartNames* parts = nullptr);
+	void ParseJson(LTS<std::string, CompositeOperation>& lts, const nlohmann::json& j, PartNames* parts = nullptr);
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "pcs/product/part_names.h"
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+
+namespace pcs {
+
+	/**
+	 * @brief The id of the part name, assigning the next id if it has not been seen. Looking up a name which is already
+	 * interned does not modify the table, so threads may share a table holding every name they use.
+	 */
+	uint32_t PartNames::Intern(const std::string& name) {
+		if (auto it = ids_.find(name); it != ids_.end()) {
+			return it->second;
+		}
+		if (names_.size() == UINT32_MAX) {
+			throw std::length_error("[Part Names] Too many part names for 32-bit ids");
+		}
+		uint32_t id = static_cast<uint32_t>(names_.size());
+		names_.emplace_back(name);
+		ids_.emplace(name, id);
+		return id;
+	}
+
+	std::optional<uint32_t> PartNames::Find(const std::string& name) const {
+		if (auto it = ids_.find(name); it != ids_.end()) {
+			return it->second;
+		}
+		return {};
+	}
+
+	const std::string& PartNames::Name(uint32_t id) const {
+		return names_.at(id);
+	}
+
+	/**
+	 * @brief The interned names, indexed by id.
+	 */
+	const std::vector<std::string>& PartNames::names() const {
+		return names_;
+	}
+
+	size_t PartNames::size() const {
+		return names_.size();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+namespace pcs {
+
+	/**
+	 * @brief Interns part names as dense ids, in order of first appearance, so that part inventories can be held as
+	 * bitsets and counts indexed by id. Ids are only comparable between inventories interning into the same table.
+	 */
+	class PartNames {
+	private:
+		std::vector<std::string> names_;
+		std::unordered_map<std::string, uint32_t> ids_;
+	public:
+		PartNames() = default;
+
+		uint32_t Intern(const std::string& name);
+		std::optional<uint32_t> Find(const std::string& name) const;
+		const std::string& Name(uint32_t id) const;
+
+		const std::vector<std::string>& names() const;
+		size_t size() const;
+	};
+
+}
\ No newline at end of file
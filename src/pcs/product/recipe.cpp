@@ -16,9 +16,17 @@ namespace pcs {
 		return lts_;
 	}
 
+	/**
+	 * @brief The names of the parts the recipe mentions, interned when it was read.
+	 */
+	const PartNames& Recipe::part_names() const {
+		return part_names_;
+	}
+
 	void Recipe::set_recipe(const std::filesystem::path& filepath) {
 		try {
-			ReadFromJsonFile(lts_, filepath);
+			part_names_ = PartNames();
+			ReadFromJsonFile(lts_, filepath, &part_names_);
 		} catch (const std::ifstream::failure& e) {
 			throw;
 		}
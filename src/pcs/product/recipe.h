@@ -5,18 +5,21 @@
 
 #include "pcs/lts/lts.h"
 #include "pcs/operation/composite.h"
+#include "pcs/product/part_names.h"
 
 namespace pcs {
 
 	class Recipe {
 	private:
 		LTS<std::string, CompositeOperation> lts_;
+		PartNames part_names_;
 	public:
 		Recipe() = default;
 		Recipe(const std::filesystem::path& filepath);
 		~Recipe() = default;
 
 		const LTS<std::string, CompositeOperation>& lts() const;
+		const PartNames& part_names() const;
 		void set_recipe(const std::filesystem::path& filepath);
 	};
 }
@@ -0,0 +1,107 @@
+#include "pcs/topology/cache.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#include <spdlog/fmt/bundled/color.h>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/common/hash.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	/*
+	 * @brief Hashes the ordered resources: initial states, and every state's transitions in their stored order.
+	 * States are visited in sorted order so the hash is independent of unordered_map iteration order, whereas
+	 * transition order is kept since it determines the order of the topology's transitions.
+	 */
+	uint64_t ContentHash(const std::vector<LTS<std::string, std::string>>& ltss) {
+		uint64_t hash = Fnv1a(std::to_string(FrozenTopology::kVersion));
+		for (const auto& lts : ltss) {
+			hash = Fnv1a(lts.initial_state(), hash);
+			std::vector<const std::string*> names;
+			names.reserve(lts.NumOfStates());
+			for (const auto& [name, state] : lts.states()) {
+				names.emplace_back(&name);
+			}
+			std::sort(names.begin(), names.end(), [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+			for (const auto* name : names) {
+				hash = Fnv1a(*name, hash);
+				for (const auto& t : lts[*name].transitions_) {
+					hash = Fnv1a(t.label(), hash);
+					hash = Fnv1a(t.to(), hash);
+				}
+				hash = Fnv1a(";", hash);
+			}
+			hash = Fnv1a("|", hash);
+		}
+		return hash;
+	}
+
+	TopologyCache::TopologyCache(const std::filesystem::path& directory)
+		: directory_(directory) {}
+
+	const std::filesystem::path& TopologyCache::directory() const {
+		return directory_;
+	}
+
+	std::filesystem::path TopologyCache::PathFor(uint64_t content_hash) const {
+		return directory_ / fmt::format("topology-{:016x}.pcst", content_hash);
+	}
+
+	/*
+	 * @brief Maps the cached topology for the given resources.
+	 * @returns nullptr when there is no entry, or the entry cannot be used (stale version, corrupt file)
+	 */
+	std::unique_ptr<FrozenTopology> TopologyCache::Load(const std::vector<LTS<std::string, std::string>>& ltss) const {
+		uint64_t hash = ContentHash(ltss);
+		std::filesystem::path path = PathFor(hash);
+		std::error_code ec;
+		if (!std::filesystem::exists(path, ec)) {
+			return nullptr;
+		}
+		try {
+			std::unique_ptr<FrozenTopology> topology = FrozenTopology::Load(path);
+			if (topology->content_hash() != hash || topology->NumOfResources() != ltss.size()) {
+				return nullptr;
+			}
+			PCS_INFO(fmt::format(fmt::fg(fmt::color::white_smoke), "[Topology Cache] Loaded {}", path.string()));
+			return topology;
+		} catch (const std::exception& e) {
+			PCS_WARN(fmt::format(fmt::fg(fmt::color::light_yellow), "[Topology Cache] Ignoring {}: {}", path.string(), e.what()));
+			return nullptr;
+		}
+	}
+
+	/*
+	 * @brief Freezes and writes the topology for the given resources. The file is written under a temporary name and
+	 * then renamed, so concurrent readers never observe a partially written entry.
+	 * @returns Whether the entry was written; failures are logged since the cache is only an optimisation.
+	 */
+	bool TopologyCache::Store(const std::vector<LTS<std::string, std::string>>& ltss, const ITopology& topology) const {
+		uint64_t hash = ContentHash(ltss);
+		std::filesystem::path path = PathFor(hash);
+		std::filesystem::path temporary = path;
+		temporary += fmt::format(".{:08x}.tmp", std::random_device()());
+		try {
+			FrozenTopology frozen(topology.lts(), hash);
+			frozen.Write(temporary);
+			std::filesystem::rename(temporary, path);
+		} catch (const std::exception& e) {
+			std::error_code ec;
+			std::filesystem::remove(temporary, ec);
+			PCS_WARN(fmt::format(fmt::fg(fmt::color::light_yellow), "[Topology Cache] Unable to write {}: {}", path.string(), e.what()));
+			return false;
+		}
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::white_smoke), "[Topology Cache] Stored {}", path.string()));
+		return true;
+	}
+
+}
\ No newline at end of file
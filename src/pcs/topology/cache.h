@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <memory>
+#include <filesystem>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/topology.h"
+#include "pcs/topology/frozen.h"
+
+namespace pcs {
+
+	uint64_t ContentHash(const std::vector<LTS<std::string, std::string>>& ltss);
+
+	/**
+	 * @brief A directory of frozen topologies keyed by the content hash of the ordered resource LTSs.
+	 * Entries are never invalidated explicitly: changing any resource changes the key and so misses the cache.
+	 */
+	class TopologyCache {
+	private:
+		std::filesystem::path directory_;
+	public:
+		TopologyCache(const std::filesystem::path& directory);
+
+		const std::filesystem::path& directory() const;
+		std::filesystem::path PathFor(uint64_t content_hash) const;
+
+		std::unique_ptr<FrozenTopology> Load(const std::vector<LTS<std::string, std::string>>& ltss) const;
+		bool Store(const std::vector<LTS<std::string, std::string>>& ltss, const ITopology& topology) const;
+	};
+
+}
\ No newline at end of file
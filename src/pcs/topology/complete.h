@@ -14,6 +14,11 @@
 
 namespace pcs {
 
+	/**
+	 * @brief The full topology, computed up front. Every state reached is stored along with its edges, so the visited
+	 * set stays exact: a bitstate set would save no memory here, and states it wrongly skipped would be left without
+	 * their outgoing edges. Use GeneratorTopology::Explore(BitStateSet&) for approximate exploration.
+	 */
 	class CompleteTopology : public ITopology {
 	private:
 		LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>> topology_;
@@ -16,28 +16,50 @@ namespace pcs {
 
 
 	/*
-	 * @brief When coming across an "in:X" or "out:X" transition, a corresponding inverse is required.
-	 * @return The end-state of applying the two transitions if found.
+	 * @brief Whether a resource transition label is a transfer, i.e. of the form "in:n" or "out:n".
 	 */
-	std::optional<std::vector<std::string>> MatchingTransfer(const std::vector<LTS<std::string, std::string>>& ltss, const std::vector<std::string>& states_vec,
-		                                    size_t current_ltss_idx, const Transition<std::string, std::string>& current_transition) {
-		TransferOperation transfer = *(StringToTransfer(current_transition.label()));
-		TransferOperation inverse = transfer.Inverse();
+	bool IsTransferLabel(const std::string& label) {
+		return (label.find("in:") != std::string::npos) || (label.find("out:") != std::string::npos);
+	}
 
+	/*
+	 * @brief Finds the first resource (other than the current one) whose local state offers the inverse transfer.
+	 * @param inverse_label: the name of the inverse transfer operation, e.g. "out:2" for a current transition of "in:2"
+	 * @return The partner resource index and its matching transition if found.
+	 */
+	std::optional<std::pair<size_t, const Transition<std::string, std::string>*>> MatchingTransferPartner(
+		const std::vector<LTS<std::string, std::string>>& ltss, const std::vector<std::string>& states_vec,
+		size_t current_ltss_idx, const std::string& inverse_label) {
 		for (size_t i = 0; i < ltss.size(); ++i) {
 			if (i == current_ltss_idx) {
 				continue;
 			}
 			for (const auto& t : ltss[i].states().at(states_vec[i]).transitions_) {
-				if (t.label().find(inverse.name()) != std::string::npos) {
-					std::vector<std::string> resulting_state = states_vec;
-					resulting_state[current_ltss_idx] = current_transition.to();
-					resulting_state[i] = t.to();
-					return resulting_state;
+				if (t.label().find(inverse_label) != std::string::npos) {
+					return std::make_pair(i, &t);
 				}
 			}
 		}
 		return {};
 	}
 
+	/*
+	 * @brief When coming across an "in:X" or "out:X" transition, a corresponding inverse is required.
+	 * @return The end-state of applying the two transitions if found.
+	 */
+	std::optional<std::vector<std::string>> MatchingTransfer(const std::vector<LTS<std::string, std::string>>& ltss, const std::vector<std::string>& states_vec,
+		                                    size_t current_ltss_idx, const Transition<std::string, std::string>& current_transition) {
+		TransferOperation transfer = *(StringToTransfer(current_transition.label()));
+		TransferOperation inverse = transfer.Inverse();
+
+		auto partner = MatchingTransferPartner(ltss, states_vec, current_ltss_idx, inverse.name());
+		if (!partner.has_value()) {
+			return {};
+		}
+		std::vector<std::string> resulting_state = states_vec;
+		resulting_state[current_ltss_idx] = current_transition.to();
+		resulting_state[partner->first] = partner->second->to();
+		return resulting_state;
+	}
+
 }
\ No newline at end of file
@@ -13,6 +13,12 @@
 
 namespace pcs {
 
+	bool IsTransferLabel(const std::string& label);
+
+	std::optional<std::pair<size_t, const Transition<std::string, std::string>*>> MatchingTransferPartner(
+		const std::vector<LTS<std::string, std::string>>& ltss, const std::vector<std::string>& states_vec,
+		size_t current_ltss_idx, const std::string& inverse_label);
+
 	std::optional<std::vector<std::string>> MatchingTransfer(const std::vector<LTS<std::string, std::string>>& ltss, const std::vector<std::string>& states_vec,
 		size_t current_ltss_idx, const Transition<std::string, std::string>& current_transition);
 
@@ -0,0 +1,275 @@
+#include "pcs/topology/external.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/indexed.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/common/external_sort.h"
+#include "pcs/common/directory.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	// Frontier states expanded per batch
+	static constexpr size_t kBlockStates = 1024;
+
+	static bool EqualKeys(const uint32_t* a, const uint32_t* b, size_t words) {
+		return std::equal(a, a + words, b);
+	}
+
+	static bool LessKeys(const uint32_t* a, const uint32_t* b, size_t words) {
+		return std::lexicographical_compare(a, a + words, b, b + words);
+	}
+
+	/*
+	 * @brief Merges the sorted unique candidates into the sorted visited states, writing the candidates which had not
+	 * been visited before to frontier and the union to merged.
+	 * @returns The number of new states
+	 */
+	static size_t MergeLayer(const std::filesystem::path& candidates, const std::filesystem::path& visited, const std::filesystem::path& frontier,
+		const std::filesystem::path& merged, size_t words) {
+		RecordReader next(candidates, words);
+		RecordReader seen(visited, words);
+		RecordWriter fresh(frontier, words);
+		RecordWriter all(merged, words);
+		while (!next.Done()) {
+			if (!seen.Done() && LessKeys(seen.Current(), next.Current(), words)) {
+				all.Write(seen.Current());
+				seen.Advance();
+			} else if (!seen.Done() && EqualKeys(seen.Current(), next.Current(), words)) {
+				all.Write(seen.Current());
+				seen.Advance();
+				next.Advance();
+			} else {
+				fresh.Write(next.Current());
+				all.Write(next.Current());
+				next.Advance();
+			}
+		}
+		for (; !seen.Done(); seen.Advance()) {
+			all.Write(seen.Current());
+		}
+		fresh.Close();
+		all.Close();
+		return fresh.count();
+	}
+
+	/*
+	 * @brief Advances the sorted visited states to the given key, whose id is the number of states before it.
+	 */
+	static uint32_t Seek(RecordReader& states, uint64_t& rank, const uint32_t* key, size_t words) {
+		while (!states.Done() && LessKeys(states.Current(), key, words)) {
+			states.Advance();
+			++rank;
+		}
+		if (states.Done() || !EqualKeys(states.Current(), key, words)) {
+			throw std::logic_error("[External Topology] Edge refers to an unexplored state");
+		}
+		return static_cast<uint32_t>(rank);
+	}
+
+	static void PadTo(std::ofstream& stream, uint64_t offset) {
+		static const char zeros[8] = {};
+		uint64_t position = static_cast<uint64_t>(stream.tellp());
+		stream.write(zeros, static_cast<std::streamsize>(offset - position));
+	}
+
+	ExternalStats ExploreExternal(const std::vector<LTS<std::string, std::string>>& ltss, const std::filesystem::path& output,
+		const ExternalOpts& opts, uint64_t content_hash) {
+		IndexedResources indexed(ltss);
+		const size_t k = indexed.NumOfResources();
+		// Edge records: source key, ordinal within the source, resource, label, target key
+		const size_t edge_words = 2 * k + 3;
+		const std::filesystem::path& dir = opts.directory;
+		std::filesystem::create_directories(dir);
+		ExternalStats stats;
+
+		std::filesystem::path visited = dir / "visited-a.bin";
+		std::filesystem::path visited_next = dir / "visited-b.bin";
+		std::filesystem::path frontier = dir / "frontier.bin";
+		std::filesystem::path candidates = dir / "candidates.bin";
+		std::filesystem::path edges_path = dir / "edges.bin";
+		std::vector<uint32_t> initial = indexed.InitialKey();
+		{
+			RecordWriter(visited, k).Write(initial.data());
+			RecordWriter(frontier, k).Write(initial.data());
+		}
+
+		// Breadth first search with delayed duplicate detection
+		RecordWriter edges(edges_path, edge_words);
+		std::vector<uint32_t> edge(edge_words);
+		StateBlock block(k);
+		EdgeBlock expanded(k);
+		size_t layer_size = 1;
+		stats.states = 1;
+		while (layer_size > 0) {
+			++stats.layers;
+			stats.max_layer = std::max(stats.max_layer, layer_size);
+			ExternalSorter successors({ .record_words = k, .key_words = k, .unique = true, .buffer_bytes = opts.buffer_bytes,
+				.directory = dir, .name = "successors" });
+			RecordReader layer(frontier, k);
+			while (!layer.Done()) {
+				block.clear();
+				for (; !layer.Done() && block.size() < kBlockStates; layer.Advance()) {
+					block.push_back(layer.Current());
+				}
+				expanded.clear();
+				indexed.ExpandBatch(block, expanded);
+				// Edges of a state are in expansion order within the block, so the block position serves as ordinal
+				for (uint32_t e = 0; e < expanded.size(); ++e) {
+					block.Row(expanded.source[e], edge.data());
+					edge[k] = e;
+					edge[k + 1] = expanded.resource[e];
+					edge[k + 2] = expanded.label[e];
+					expanded.targets.Row(e, edge.data() + k + 3);
+					edges.Write(edge.data());
+					successors.Add(edge.data() + k + 3);
+				}
+			}
+			successors.Finish(candidates);
+			stats.runs += successors.NumOfRuns();
+			layer_size = MergeLayer(candidates, visited, frontier, visited_next, k);
+			std::swap(visited, visited_next);
+			stats.states += layer_size;
+			PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[External Topology] Layer {} added {} states", stats.layers, layer_size));
+		}
+		edges.Close();
+		stats.transitions = edges.count();
+		if (stats.states > FrozenTopology::kNoState) {
+			throw std::length_error("[External Topology] Too many states for 32-bit state ids");
+		}
+
+		// Replace target keys by ids, then order by source (and ordinal, preserving the expansion order per state)
+		std::filesystem::path by_target = dir / "edges-by-target.bin";
+		std::filesystem::path by_source = dir / "edges-by-source.bin";
+		{
+			ExternalSorter sorter({ .record_words = edge_words, .key_offset = k + 3, .key_words = k, .buffer_bytes = opts.buffer_bytes,
+				.directory = dir, .name = "targets" });
+			for (RecordReader reader(edges_path, edge_words); !reader.Done(); reader.Advance()) {
+				sorter.Add(reader.Current());
+			}
+			sorter.Finish(by_target);
+			stats.runs += sorter.NumOfRuns();
+		}
+		{
+			ExternalSorter sorter({ .record_words = k + 4, .key_words = k + 1, .buffer_bytes = opts.buffer_bytes,
+				.directory = dir, .name = "sources" });
+			RecordReader states(visited, k);
+			uint64_t rank = 0;
+			std::vector<uint32_t> joined(k + 4);
+			for (RecordReader reader(by_target, edge_words); !reader.Done(); reader.Advance()) {
+				const uint32_t* record = reader.Current();
+				std::copy(record, record + k + 3, joined.begin());
+				joined[k + 3] = Seek(states, rank, record + k + 3, k);
+				sorter.Add(joined.data());
+			}
+			sorter.Finish(by_source);
+			stats.runs += sorter.NumOfRuns();
+		}
+
+		// String table in lexicographic order, local ids are ordered by name so the mapped keys stay sorted
+		std::set<std::string> names;
+		for (size_t r = 0; r < k; ++r) {
+			for (uint32_t i = 0; i < indexed.NumOfLocalStates(r); ++i) {
+				names.insert(indexed.LocalName(r, i));
+			}
+		}
+		for (uint32_t i = 0; i < indexed.NumOfLabels(); ++i) {
+			names.insert(indexed.Label(i));
+		}
+		std::vector<std::string> strings(names.begin(), names.end());
+		auto string_id = [&](const std::string& str) {
+			return static_cast<uint32_t>(std::lower_bound(strings.begin(), strings.end(), str) - strings.begin());
+		};
+		std::vector<std::vector<uint32_t>> local_strings(k);
+		for (size_t r = 0; r < k; ++r) {
+			for (uint32_t i = 0; i < indexed.NumOfLocalStates(r); ++i) {
+				local_strings[r].emplace_back(string_id(indexed.LocalName(r, i)));
+			}
+		}
+		std::vector<uint32_t> label_strings;
+		uint64_t string_bytes = 0;
+		for (uint32_t i = 0; i < indexed.NumOfLabels(); ++i) {
+			label_strings.emplace_back(string_id(indexed.Label(i)));
+		}
+		for (const auto& str : strings) {
+			string_bytes += str.size();
+		}
+
+		// Stream the sections in file order
+		FrozenTopology::Header header = FrozenTopology::Layout(k, stats.states, stats.transitions, strings.size(), string_bytes, 0);
+		header.content_hash = content_hash;
+		std::ofstream stream;
+		stream.exceptions(std::ofstream::badbit | std::ofstream::failbit);
+		CreateDirectoryForPath(output);
+		stream.open(output, std::ios::out | std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		PadTo(stream, header.string_offsets);
+		uint64_t cursor = 0;
+		for (const auto& str : strings) {
+			stream.write(reinterpret_cast<const char*>(&cursor), sizeof(cursor));
+			cursor += str.size();
+		}
+		stream.write(reinterpret_cast<const char*>(&cursor), sizeof(cursor));
+		PadTo(stream, header.string_data);
+		for (const auto& str : strings) {
+			stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+		}
+
+		PadTo(stream, header.keys);
+		{
+			std::vector<uint32_t> row(k);
+			uint64_t rank = 0;
+			for (RecordReader states(visited, k); !states.Done(); states.Advance(), ++rank) {
+				if (EqualKeys(states.Current(), initial.data(), k)) {
+					header.initial_state = rank;
+				}
+				for (size_t r = 0; r < k; ++r) {
+					row[r] = local_strings[r][states.Current()[r]];
+				}
+				stream.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(k * sizeof(uint32_t)));
+			}
+		}
+
+		PadTo(stream, header.edge_offsets);
+		{
+			RecordReader reader(by_source, k + 4);
+			uint64_t offset = 0;
+			for (RecordReader states(visited, k); !states.Done(); states.Advance()) {
+				stream.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+				for (; !reader.Done() && EqualKeys(reader.Current(), states.Current(), k); reader.Advance()) {
+					++offset;
+				}
+			}
+			stream.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+		}
+
+		PadTo(stream, header.edges);
+		for (RecordReader reader(by_source, k + 4); !reader.Done(); reader.Advance()) {
+			const uint32_t* record = reader.Current();
+			FrozenTopology::Edge e{ record[k + 3], record[k + 1], label_strings[record[k + 2]] };
+			stream.write(reinterpret_cast<const char*>(&e), sizeof(e));
+		}
+		PadTo(stream, header.size);
+		stream.seekp(0);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.close();
+
+		std::error_code ec;
+		for (const auto& path : { visited, visited_next, frontier, candidates, edges_path, by_target, by_source }) {
+			std::filesystem::remove(path, ec);
+		}
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[External Topology] Wrote {} states and {} transitions to {}",
+			stats.states, stats.transitions, output.string()));
+		return stats;
+	}
+
+}
\ No newline at end of file
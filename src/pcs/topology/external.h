@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "pcs/lts/lts.h"
+
+namespace pcs {
+
+	/**
+	 * @brief Options for ExploreExternal.
+	 * @param directory: scratch space for the BFS layers, sort runs and edge files, which are removed afterwards
+	 * @param buffer_bytes: memory budget of each in-memory sort, which bounds the memory used by the exploration
+	 */
+	struct ExternalOpts {
+		std::filesystem::path directory;
+		size_t buffer_bytes = 64 * 1024 * 1024;
+	};
+
+	struct ExternalStats {
+		size_t states = 0;
+		size_t transitions = 0;
+		size_t layers = 0;
+		size_t runs = 0;
+		size_t max_layer = 0;
+	};
+
+	/**
+	 * @brief Explores the complete topology of the resources breadth first without holding it in memory, and writes it
+	 * to output in the FrozenTopology format (keys sorted, no hash index) so it can be loaded with FrozenTopology::Load.
+	 *
+	 * Uses delayed duplicate detection: the successors of a layer are externally sorted into unique runs and merged
+	 * against the sorted file of visited states, rather than being looked up in an in-memory visited set. Edges are
+	 * streamed to disk during the search and joined with the final state ids by two further external sorts.
+	 * @exception Propagates std::ios_base::failure on I/O errors
+	 */
+	ExternalStats ExploreExternal(const std::vector<LTS<std::string, std::string>>& ltss, const std::filesystem::path& output,
+		const ExternalOpts& opts, uint64_t content_hash = 0);
+
+}
\ No newline at end of file
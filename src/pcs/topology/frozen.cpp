@@ -0,0 +1,513 @@
+#include "pcs/topology/frozen.h"
+
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/common/hash.h"
+#include "pcs/common/directory.h"
+#include "pcs/common/mapped_file.h"
+#include "pcs/common/shared_memory.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	static constexpr char kMagic[4] = { 'P', 'C', 'S', 'T' };
+	static constexpr uint32_t kByteOrder = 0x01020304;
+
+	static size_t Align(size_t offset) {
+		return (offset + 7) & ~static_cast<size_t>(7);
+	}
+
+	static uint64_t HashIds(const uint32_t* ids, size_t count) {
+		return Mix64(Fnv1aBytes(ids, count * sizeof(uint32_t)));
+	}
+
+	static uint64_t IndexCapacity(size_t num_states) {
+		uint64_t capacity = 2;
+		while (capacity < num_states * 2) {
+			capacity <<= 1;
+		}
+		return capacity;
+	}
+
+	static void InsertIndex(FrozenTopology::StateId* index, uint64_t capacity, const uint32_t* row, size_t num_resources, FrozenTopology::StateId id) {
+		uint64_t slot = HashIds(row, num_resources) & (capacity - 1);
+		while (index[slot] != FrozenTopology::kNoState) {
+			slot = (slot + 1) & (capacity - 1);
+		}
+		index[slot] = id;
+	}
+
+	// ==========================
+	// Constructors
+	// ==========================
+
+	/**
+	 * @brief Freezes an existing topology LTS. Transition targets which have no State of their own (e.g. unexpanded
+	 * states of an IncrementalTopology) become states without outgoing edges.
+	 * @param content_hash: hash of the resources the topology was built from, see ContentHash()
+	 */
+	FrozenTopology::FrozenTopology(const TopologyLTS& lts, uint64_t content_hash) {
+		const size_t num_resources = lts.initial_state().size();
+
+		// Assign state ids in iteration order, followed by any states only referenced as targets
+		std::unordered_map<std::vector<std::string>, StateId, boost::hash<std::vector<std::string>>> ids;
+		std::vector<const std::vector<std::string>*> order;
+		auto assign = [&](const std::vector<std::string>& key) {
+			auto [it, inserted] = ids.try_emplace(key, static_cast<StateId>(order.size()));
+			if (inserted) {
+				order.emplace_back(&it->first);
+			}
+			return it->second;
+		};
+		for (const auto& [key, state] : lts.states()) {
+			assign(key);
+		}
+		StateId initial = assign(lts.initial_state());
+		size_t num_edges = 0;
+		for (const auto& [key, state] : lts.states()) {
+			for (const auto& t : state.transitions_) {
+				assign(t.to());
+			}
+			num_edges += state.transitions_.size();
+		}
+
+		// Intern local state names and labels
+		std::vector<std::string_view> strings;
+		std::unordered_map<std::string_view, uint32_t> string_ids;
+		auto intern = [&](std::string_view str) {
+			auto [it, inserted] = string_ids.try_emplace(str, static_cast<uint32_t>(strings.size()));
+			if (inserted) {
+				strings.emplace_back(str);
+			}
+			return it->second;
+		};
+		size_t string_bytes = 0;
+		for (const auto* key : order) {
+			for (const auto& local : *key) {
+				intern(local);
+			}
+		}
+		for (const auto& [key, state] : lts.states()) {
+			for (const auto& t : state.transitions_) {
+				intern(t.label().second);
+			}
+		}
+		for (const auto& str : strings) {
+			string_bytes += str.size();
+		}
+
+		Header header = Layout(num_resources, order.size(), num_edges, strings.size(), string_bytes, IndexCapacity(order.size()));
+		header.content_hash = content_hash;
+		header.initial_state = initial;
+
+		std::vector<std::byte> owned(header.size);
+		std::byte* base = owned.data();
+		std::memcpy(base, &header, sizeof(Header));
+
+		uint64_t* string_offsets = reinterpret_cast<uint64_t*>(base + header.string_offsets);
+		char* string_data = reinterpret_cast<char*>(base + header.string_data);
+		size_t cursor = 0;
+		for (size_t i = 0; i < strings.size(); ++i) {
+			string_offsets[i] = cursor;
+			std::memcpy(string_data + cursor, strings[i].data(), strings[i].size());
+			cursor += strings[i].size();
+		}
+		string_offsets[strings.size()] = cursor;
+
+		uint32_t* keys = reinterpret_cast<uint32_t*>(base + header.keys);
+		uint64_t* edge_offsets = reinterpret_cast<uint64_t*>(base + header.edge_offsets);
+		Edge* edges = reinterpret_cast<Edge*>(base + header.edges);
+		StateId* index = reinterpret_cast<StateId*>(base + header.index);
+		std::fill(index, index + header.index_capacity, kNoState);
+
+		size_t edge_cursor = 0;
+		for (StateId id = 0; id < order.size(); ++id) {
+			const std::vector<std::string>& key = *order[id];
+			uint32_t* row = keys + static_cast<size_t>(id) * num_resources;
+			for (size_t r = 0; r < num_resources; ++r) {
+				row[r] = string_ids.at(key[r]);
+			}
+			InsertIndex(index, header.index_capacity, row, num_resources, id);
+
+			edge_offsets[id] = edge_cursor;
+			if (lts.HasState(key)) {
+				for (const auto& t : lts[key].transitions_) {
+					edges[edge_cursor++] = Edge{ ids.at(t.to()), static_cast<uint32_t>(t.label().first), string_ids.at(t.label().second) };
+				}
+			}
+		}
+		edge_offsets[order.size()] = edge_cursor;
+
+		storage_ = std::move(owned);
+		const auto& bytes = std::get<std::vector<std::byte>>(storage_);
+		Bind(bytes.data(), bytes.size());
+	}
+
+	/**
+	 * @brief Adopts an in-memory topology, e.g. one produced by Permute().
+	 * @exception Throws std::runtime_error if the bytes do not hold a valid topology of this version
+	 */
+	FrozenTopology::FrozenTopology(std::vector<std::byte>&& bytes)
+		: storage_(std::move(bytes)) {
+		const auto& owned = std::get<std::vector<std::byte>>(storage_);
+		Bind(owned.data(), owned.size());
+	}
+
+	/**
+	 * @brief Adopts a mapped topology file.
+	 * @exception Throws std::runtime_error if the mapping does not hold a valid topology of this version
+	 */
+	FrozenTopology::FrozenTopology(MappedFile&& mapped)
+		: storage_(std::move(mapped)) {
+		const auto& file = std::get<MappedFile>(storage_);
+		Bind(file.data(), file.size());
+	}
+
+	/**
+	 * @brief Adopts an attached shared memory segment.
+	 * @exception Throws std::runtime_error if the segment does not hold a valid topology of this version
+	 */
+	FrozenTopology::FrozenTopology(SharedMemory&& shared)
+		: storage_(std::move(shared)) {
+		const auto& segment = std::get<SharedMemory>(storage_);
+		Bind(segment.data(), segment.size());
+	}
+
+	/**
+	 * @brief The header of a topology with the given sizes, with all section offsets computed. Used by writers which
+	 * stream sections to disk rather than freezing an in-memory LTS.
+	 * @param index_capacity: 0 to omit the hash index, in which case the keys must be written in ascending order
+	 */
+	FrozenTopology::Header FrozenTopology::Layout(size_t num_resources, uint64_t num_states, uint64_t num_edges, uint64_t num_strings,
+		uint64_t string_bytes, uint64_t index_capacity) {
+		Header header{};
+		std::memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version = kVersion;
+		header.byte_order = kByteOrder;
+		header.num_resources = static_cast<uint32_t>(num_resources);
+		header.num_states = num_states;
+		header.num_edges = num_edges;
+		header.num_strings = num_strings;
+		header.index_capacity = index_capacity;
+		header.string_offsets = Align(sizeof(Header));
+		header.string_data = Align(header.string_offsets + (header.num_strings + 1) * sizeof(uint64_t));
+		header.keys = Align(header.string_data + string_bytes);
+		header.edge_offsets = Align(header.keys + header.num_states * num_resources * sizeof(uint32_t));
+		header.edges = Align(header.edge_offsets + (header.num_states + 1) * sizeof(uint64_t));
+		header.index = Align(header.edges + header.num_edges * sizeof(Edge));
+		header.size = Align(header.index + header.index_capacity * sizeof(StateId));
+		return header;
+	}
+
+	/**
+	 * @brief Maps a topology file previously produced by Write().
+	 * @exception Propagates std::system_error from mapping, std::runtime_error for malformed files
+	 */
+	std::unique_ptr<FrozenTopology> FrozenTopology::Load(const std::filesystem::path& path) {
+		return std::make_unique<FrozenTopology>(MappedFile(path));
+	}
+
+	/*
+	 * @brief Writes the binary representation, which can later be mapped with Load().
+	 * @exception Propagates std::ofstream::failure
+	 */
+	void FrozenTopology::Write(const std::filesystem::path& path) const {
+		std::ofstream stream;
+		stream.exceptions(std::ofstream::badbit | std::ofstream::failbit);
+		CreateDirectoryForPath(path);
+		try {
+			stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			stream.write(reinterpret_cast<const char*>(bytes().data()), static_cast<std::streamsize>(bytes().size()));
+		} catch (const std::ofstream::failure& e) {
+			throw;
+		}
+	}
+
+	/**
+	 * @brief Attaches read-only to a topology published by another process, without copying it.
+	 * @exception Propagates std::system_error when no such segment exists, std::runtime_error for malformed segments
+	 */
+	std::unique_ptr<FrozenTopology> FrozenTopology::Attach(const std::string& name) {
+		return std::make_unique<FrozenTopology>(SharedMemory::Open(name));
+	}
+
+	/**
+	 * @brief Copies the topology into a named shared memory segment. The magic is written last so that a process
+	 * attaching mid-publish is rejected as malformed rather than reading a partial topology.
+	 * @returns The segment, which should be kept alive by the publisher (required on Windows, see SharedMemory)
+	 * @exception Propagates std::system_error
+	 */
+	SharedMemory FrozenTopology::Publish(const std::string& name) const {
+		std::span<const std::byte> source = bytes();
+		SharedMemory shared = SharedMemory::Create(name, source.size());
+		std::byte* target = shared.mutable_data();
+		std::memcpy(target + sizeof(kMagic), source.data() + sizeof(kMagic), source.size() - sizeof(kMagic));
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(target, source.data(), sizeof(kMagic));
+		return shared;
+	}
+
+	/**
+	 * @brief A copy of the topology with its states renumbered, so that the state stored at new id i is the state
+	 * at old id order[i]. Keys and edge lists are laid out in the new order and the hash index is rebuilt.
+	 * @param order: a permutation of all state ids
+	 * @exception Throws std::invalid_argument if order is not a permutation of the state ids
+	 */
+	std::unique_ptr<FrozenTopology> FrozenTopology::Permute(std::span<const StateId> order) const {
+		const size_t num_states = NumOfStates();
+		const size_t num_resources = NumOfResources();
+		std::vector<StateId> renamed(num_states, kNoState);
+		if (order.size() != num_states) {
+			throw std::invalid_argument("[Frozen Topology] Order is not a permutation of the states");
+		}
+		for (StateId i = 0; i < num_states; ++i) {
+			if (order[i] >= num_states || renamed[order[i]] != kNoState) {
+				throw std::invalid_argument("[Frozen Topology] Order is not a permutation of the states");
+			}
+			renamed[order[i]] = i;
+		}
+
+		const uint64_t string_bytes = string_offsets_[header_->num_strings];
+		Header header = Layout(num_resources, num_states, NumOfTransitions(), header_->num_strings, string_bytes, IndexCapacity(num_states));
+		header.content_hash = header_->content_hash;
+		header.initial_state = renamed[initial_id()];
+
+		std::vector<std::byte> owned(header.size);
+		std::byte* base = owned.data();
+		std::memcpy(base, &header, sizeof(Header));
+		std::memcpy(base + header.string_offsets, string_offsets_, (header.num_strings + 1) * sizeof(uint64_t));
+		std::memcpy(base + header.string_data, string_data_, string_bytes);
+
+		uint32_t* keys = reinterpret_cast<uint32_t*>(base + header.keys);
+		uint64_t* edge_offsets = reinterpret_cast<uint64_t*>(base + header.edge_offsets);
+		Edge* edges = reinterpret_cast<Edge*>(base + header.edges);
+		StateId* index = reinterpret_cast<StateId*>(base + header.index);
+		std::fill(index, index + header.index_capacity, kNoState);
+
+		size_t edge_cursor = 0;
+		for (StateId id = 0; id < num_states; ++id) {
+			const uint32_t* old_row = keys_ + static_cast<size_t>(order[id]) * num_resources;
+			uint32_t* row = keys + static_cast<size_t>(id) * num_resources;
+			std::copy(old_row, old_row + num_resources, row);
+			InsertIndex(index, header.index_capacity, row, num_resources, id);
+
+			edge_offsets[id] = edge_cursor;
+			for (const Edge& e : Edges(order[id])) {
+				edges[edge_cursor++] = Edge{ renamed[e.to], e.resource, e.label };
+			}
+		}
+		edge_offsets[num_states] = edge_cursor;
+		return std::make_unique<FrozenTopology>(std::move(owned));
+	}
+
+	/*
+	 * @brief Validates the header, section bounds, offsets and ids, then points the section views into the given bytes.
+	 */
+	void FrozenTopology::Bind(const std::byte* data, size_t size) {
+		if (data == nullptr || size < sizeof(Header)) {
+			throw std::runtime_error("[Frozen Topology] Truncated topology header");
+		}
+		header_ = reinterpret_cast<const Header*>(data);
+		if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0 || header_->byte_order != kByteOrder) {
+			throw std::runtime_error("[Frozen Topology] Not a topology file");
+		}
+		if (header_->version != kVersion) {
+			throw std::runtime_error("[Frozen Topology] Unsupported topology file version " + std::to_string(header_->version));
+		}
+		auto section_fits = [&](uint64_t offset, uint64_t bytes) {
+			return (offset % 8 == 0) && (offset <= size) && (bytes <= size - offset);
+		};
+		const uint64_t num_resources = header_->num_resources;
+		// Mappings may be rounded up to a whole number of pages
+		bool valid = (header_->size <= size) && (header_->initial_state < header_->num_states)
+			&& (header_->index_capacity == 0 || header_->index_capacity > header_->num_states)
+			&& ((header_->index_capacity & (header_->index_capacity - 1)) == 0)
+			&& section_fits(header_->string_offsets, (header_->num_strings + 1) * sizeof(uint64_t))
+			&& section_fits(header_->keys, header_->num_states * num_resources * sizeof(uint32_t))
+			&& section_fits(header_->edge_offsets, (header_->num_states + 1) * sizeof(uint64_t))
+			&& section_fits(header_->edges, header_->num_edges * sizeof(Edge))
+			&& section_fits(header_->index, header_->index_capacity * sizeof(StateId));
+		if (!valid) {
+			throw std::runtime_error("[Frozen Topology] Malformed topology sections");
+		}
+		string_offsets_ = reinterpret_cast<const uint64_t*>(data + header_->string_offsets);
+		string_data_ = reinterpret_cast<const char*>(data + header_->string_data);
+		keys_ = reinterpret_cast<const uint32_t*>(data + header_->keys);
+		edge_offsets_ = reinterpret_cast<const uint64_t*>(data + header_->edge_offsets);
+		edges_ = reinterpret_cast<const Edge*>(data + header_->edges);
+		index_ = reinterpret_cast<const StateId*>(data + header_->index);
+		if (!section_fits(header_->string_data, string_offsets_[header_->num_strings]) || edge_offsets_[header_->num_states] != header_->num_edges) {
+			throw std::runtime_error("[Frozen Topology] Malformed topology sections");
+		}
+		// The accessors index by the stored offsets and ids without checks, so a corrupt or stale file must fail here
+		if (string_offsets_[0] != 0 || edge_offsets_[0] != 0
+			|| !std::is_sorted(string_offsets_, string_offsets_ + header_->num_strings + 1)
+			|| !std::is_sorted(edge_offsets_, edge_offsets_ + header_->num_states + 1)) {
+			throw std::runtime_error("[Frozen Topology] Malformed topology offsets");
+		}
+		bool ids_valid = std::all_of(keys_, keys_ + header_->num_states * num_resources, [&](uint32_t id) { return id < header_->num_strings; })
+			&& std::all_of(edges_, edges_ + header_->num_edges, [&](const Edge& edge) {
+				return edge.to < header_->num_states && edge.resource < num_resources && edge.label < header_->num_strings;
+			})
+			&& std::all_of(index_, index_ + header_->index_capacity, [&](StateId id) { return id == kNoState || id < header_->num_states; });
+		if (!ids_valid) {
+			throw std::runtime_error("[Frozen Topology] Malformed topology ids");
+		}
+
+		string_ids_.clear();
+		string_ids_.reserve(header_->num_strings);
+		for (uint32_t i = 0; i < header_->num_strings; ++i) {
+			string_ids_.emplace(String(i), i);
+		}
+		topology_.set_initial_state(Key(initial_id()), false);
+	}
+
+	// ==========================
+	// ITopology
+	// ==========================
+
+	/*
+	 * @brief Materialises every state on first use, prefer the id based accessors for large topologies.
+	 */
+	const FrozenTopology::TopologyLTS& FrozenTopology::lts() const {
+		if (topology_.NumOfStates() != NumOfStates()) {
+			for (StateId id = 0; id < NumOfStates(); ++id) {
+				Materialise(id);
+			}
+		}
+		return topology_;
+	}
+
+	const State<std::vector<std::string>, std::pair<size_t, std::string>>& FrozenTopology::at(const std::vector<std::string>& key) {
+		std::optional<StateId> id = Find(key);
+		if (!id.has_value()) {
+			throw std::out_of_range("[Frozen Topology] State is not part of the topology");
+		}
+		return Materialise(*id);
+	}
+
+	const std::vector<std::string>& FrozenTopology::initial_state() const {
+		return topology_.initial_state();
+	}
+
+	const State<std::vector<std::string>, std::pair<size_t, std::string>>& FrozenTopology::Materialise(StateId state) const {
+		std::vector<std::string> key = Key(state);
+		if (topology_.HasState(key)) {
+			return topology_[key];
+		}
+		topology_.AddState(key);
+		for (const Edge& e : Edges(state)) {
+			topology_.AddTransition(key, std::make_pair(static_cast<size_t>(e.resource), std::string(String(e.label))), Key(e.to), false);
+		}
+		return topology_[key];
+	}
+
+	// ==========================
+	// Id based accessors
+	// ==========================
+
+	uint64_t FrozenTopology::content_hash() const {
+		return header_->content_hash;
+	}
+
+	size_t FrozenTopology::NumOfResources() const {
+		return header_->num_resources;
+	}
+
+	size_t FrozenTopology::NumOfStates() const {
+		return header_->num_states;
+	}
+
+	size_t FrozenTopology::NumOfTransitions() const {
+		return header_->num_edges;
+	}
+
+	std::span<const std::byte> FrozenTopology::bytes() const {
+		return std::span<const std::byte>(reinterpret_cast<const std::byte*>(header_), header_->size);
+	}
+
+	FrozenTopology::StateId FrozenTopology::initial_id() const {
+		return static_cast<StateId>(header_->initial_state);
+	}
+
+	std::optional<FrozenTopology::StateId> FrozenTopology::Find(const std::vector<std::string>& key) const {
+		if (key.size() != NumOfResources()) {
+			return {};
+		}
+		std::vector<uint32_t> ids(key.size());
+		for (size_t r = 0; r < key.size(); ++r) {
+			auto it = string_ids_.find(std::string_view(key[r]));
+			if (it == string_ids_.end()) {
+				return {};
+			}
+			ids[r] = it->second;
+		}
+		return Find(ids.data());
+	}
+
+	/*
+	 * @brief Probes the hash index, or binary searches the keys of topologies written without an index.
+	 */
+	std::optional<FrozenTopology::StateId> FrozenTopology::Find(const uint32_t* ids) const {
+		const size_t num_resources = NumOfResources();
+		if (header_->index_capacity == 0) {
+			size_t low = 0, high = NumOfStates();
+			while (low < high) {
+				size_t mid = low + (high - low) / 2;
+				const uint32_t* row = keys_ + mid * num_resources;
+				if (std::lexicographical_compare(row, row + num_resources, ids, ids + num_resources)) {
+					low = mid + 1;
+				} else {
+					high = mid;
+				}
+			}
+			if (low < NumOfStates() && std::equal(ids, ids + num_resources, keys_ + low * num_resources)) {
+				return static_cast<StateId>(low);
+			}
+			return {};
+		}
+		const uint64_t mask = header_->index_capacity - 1;
+		for (uint64_t slot = HashIds(ids, num_resources) & mask; index_[slot] != kNoState; slot = (slot + 1) & mask) {
+			const uint32_t* row = keys_ + static_cast<size_t>(index_[slot]) * num_resources;
+			if (std::equal(row, row + num_resources, ids)) {
+				return index_[slot];
+			}
+		}
+		return {};
+	}
+
+	std::string_view FrozenTopology::LocalState(StateId state, size_t resource) const {
+		return String(keys_[static_cast<size_t>(state) * NumOfResources() + resource]);
+	}
+
+	std::vector<std::string> FrozenTopology::Key(StateId state) const {
+		std::vector<std::string> key;
+		key.reserve(NumOfResources());
+		for (size_t r = 0; r < NumOfResources(); ++r) {
+			key.emplace_back(LocalState(state, r));
+		}
+		return key;
+	}
+
+	std::span<const FrozenTopology::Edge> FrozenTopology::Edges(StateId state) const {
+		return std::span<const Edge>(edges_ + edge_offsets_[state], edges_ + edge_offsets_[state + 1]);
+	}
+
+	std::string_view FrozenTopology::String(uint32_t id) const {
+		return std::string_view(string_data_ + string_offsets_[id], string_offsets_[id + 1] - string_offsets_[id]);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <optional>
+#include <filesystem>
+#include <variant>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/topology.h"
+#include "pcs/common/mapped_file.h"
+#include "pcs/common/shared_memory.h"
+
+namespace pcs {
+
+	/**
+	 * @brief An immutable topology in a compact, position-independent binary layout (interned strings, CSR edges and
+	 * an open-addressed key index). The same bytes are used in memory and on disk, so a written file can be mapped
+	 * and queried directly without parsing, or published into shared memory for other processes to attach to.
+	 *
+	 * ITopology queries materialise LTS states on demand, only the states which have been asked for are duplicated.
+	 */
+	class FrozenTopology : public ITopology {
+	public:
+		using StateId = uint32_t;
+		using TopologyLTS = LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>;
+
+		static constexpr uint32_t kVersion = 1;
+		static constexpr StateId kNoState = UINT32_MAX;
+
+		struct Edge {
+			StateId to;
+			uint32_t resource;
+			uint32_t label;
+		};
+
+		/**
+		 * @brief File header, all section offsets are in bytes from the start of the file and 8-byte aligned. An
+		 * index_capacity of 0 means there is no hash index and the keys are stored in ascending order instead.
+		 */
+		struct Header {
+			char magic[4];
+			uint32_t version;
+			uint32_t byte_order;
+			uint32_t num_resources;
+			uint64_t content_hash;
+			uint64_t num_states;
+			uint64_t num_edges;
+			uint64_t num_strings;
+			uint64_t index_capacity;
+			uint64_t initial_state;
+			uint64_t string_offsets;
+			uint64_t string_data;
+			uint64_t keys;
+			uint64_t edge_offsets;
+			uint64_t edges;
+			uint64_t index;
+			uint64_t size;
+		};
+	private:
+		std::variant<std::vector<std::byte>, MappedFile, SharedMemory> storage_;
+
+		const Header* header_ = nullptr;
+		const uint64_t* string_offsets_ = nullptr;
+		const char* string_data_ = nullptr;
+		const uint32_t* keys_ = nullptr;
+		const uint64_t* edge_offsets_ = nullptr;
+		const Edge* edges_ = nullptr;
+		const StateId* index_ = nullptr;
+		std::unordered_map<std::string_view, uint32_t> string_ids_;
+
+		mutable TopologyLTS topology_;
+	public:
+		FrozenTopology(const TopologyLTS& lts, uint64_t content_hash = 0);
+		explicit FrozenTopology(std::vector<std::byte>&& bytes);
+		explicit FrozenTopology(MappedFile&& mapped);
+		explicit FrozenTopology(SharedMemory&& shared);
+
+		static Header Layout(size_t num_resources, uint64_t num_states, uint64_t num_edges, uint64_t num_strings, uint64_t string_bytes,
+			uint64_t index_capacity);
+		static std::unique_ptr<FrozenTopology> Load(const std::filesystem::path& path);
+		void Write(const std::filesystem::path& path) const;
+
+		static std::unique_ptr<FrozenTopology> Attach(const std::string& name);
+		SharedMemory Publish(const std::string& name) const;
+
+		std::unique_ptr<FrozenTopology> Permute(std::span<const StateId> order) const;
+
+		const TopologyLTS& lts() const override;
+		const State<std::vector<std::string>, std::pair<size_t, std::string>>& at(const std::vector<std::string>& key) override;
+		const std::vector<std::string>& initial_state() const override;
+
+		uint64_t content_hash() const;
+		size_t NumOfResources() const;
+		size_t NumOfStates() const;
+		size_t NumOfTransitions() const;
+		std::span<const std::byte> bytes() const;
+
+		StateId initial_id() const;
+		std::optional<StateId> Find(const std::vector<std::string>& key) const;
+		std::string_view LocalState(StateId state, size_t resource) const;
+		std::vector<std::string> Key(StateId state) const;
+		std::span<const Edge> Edges(StateId state) const;
+		std::string_view String(uint32_t id) const;
+	private:
+		void Bind(const std::byte* data, size_t size);
+		std::optional<StateId> Find(const uint32_t* ids) const;
+		const State<std::vector<std::string>, std::pair<size_t, std::string>>& Materialise(StateId state) const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "pcs/topology/generator.h"
+
+#include <vector>
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <spdlog/fmt/ranges.h>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+#include "pcs/operation/parsers/label.h"
+#include "pcs/common/hash.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	// ==========================
+	// SuccessorIterator
+	// ==========================
+
+	SuccessorIterator::SuccessorIterator(const GeneratorTopology* topology, const std::vector<std::string>* key)
+		: topology_(topology), key_(key) {
+		Settle();
+	}
+
+	SuccessorIterator::reference SuccessorIterator::operator*() const {
+		return current_;
+	}
+
+	SuccessorIterator::pointer SuccessorIterator::operator->() const {
+		return &current_;
+	}
+
+	SuccessorIterator& SuccessorIterator::operator++() {
+		++transition_;
+		Settle();
+		return *this;
+	}
+
+	bool SuccessorIterator::operator==(std::default_sentinel_t) const {
+		return (topology_ == nullptr) || (resource_ >= topology_->resources().size());
+	}
+
+	/*
+	 * @brief Moves to the next valid successor at or after the current (resource, transition) position.
+	 * Transfers without a matching inverse in another resource are skipped, as with CombineRecursive.
+	 */
+	void SuccessorIterator::Settle() {
+		const auto& ltss = topology_->resources();
+		while (resource_ < ltss.size()) {
+			if (local_ == nullptr) {
+				local_ = &(*ltss[resource_].states().find((*key_)[resource_]));
+			}
+			const auto& transitions = local_->second.transitions_;
+			while (transition_ < transitions.size()) {
+				const auto& t = transitions[transition_];
+				current_ = Successor{ .resource = resource_, .label = &t.label(), .from = &local_->first, .to = &t.to() };
+				if (!IsTransferLabel(t.label())) {
+					return;
+				}
+				auto partner = MatchingTransferPartner(ltss, *key_, resource_, topology_->InverseOf(t.label()));
+				if (partner.has_value()) {
+					current_.partner = partner->first;
+					current_.partner_from = &(ltss[partner->first].states().find((*key_)[partner->first])->first);
+					current_.partner_to = &(partner->second->to());
+					return;
+				}
+				++transition_;
+			}
+			++resource_;
+			transition_ = 0;
+			local_ = nullptr;
+		}
+	}
+
+	SuccessorRange::SuccessorRange(const GeneratorTopology* topology, const std::vector<std::string>* key)
+		: begin_(topology, key) {}
+
+	SuccessorIterator SuccessorRange::begin() const {
+		return begin_;
+	}
+
+	std::default_sentinel_t SuccessorRange::end() const {
+		return std::default_sentinel;
+	}
+
+	// ==========================
+	// GeneratorTopology
+	// ==========================
+
+	GeneratorTopology::GeneratorTopology(const std::vector<LTS<std::string, std::string>>& ltss)
+		: ltss_(ltss) {
+		std::vector<std::string> initial_key;
+		initial_key.reserve(ltss_.size());
+		for (const auto& lts : ltss_) {
+			initial_key.emplace_back(lts.initial_state());
+			for (const auto& [name, state] : lts.states()) {
+				for (const auto& t : state.transitions_) {
+					if (IsTransferLabel(t.label()) && !inverse_labels_.contains(t.label())) {
+						inverse_labels_.emplace(t.label(), StringToTransfer(t.label())->Inverse().name());
+					}
+				}
+			}
+		}
+		topology_.set_initial_state(initial_key, false);
+	}
+
+	/*
+	 * @brief Only the states materialised through at() are present, the generator itself never stores edges.
+	 */
+	const LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>& GeneratorTopology::lts() const {
+		return topology_;
+	}
+
+	const std::vector<std::string>& GeneratorTopology::initial_state() const {
+		return topology_.initial_state();
+	}
+
+	const std::vector<LTS<std::string, std::string>>& GeneratorTopology::resources() const {
+		return ltss_;
+	}
+
+	const std::string& GeneratorTopology::InverseOf(const std::string& transfer_label) const {
+		return inverse_labels_.at(transfer_label);
+	}
+
+	/*
+	 * @brief Materialises a single state for callers which require a State reference, e.g. the Controller.
+	 * Prefer Successors() where possible, as materialised states are retained for the lifetime of the topology.
+	 */
+	const State<std::vector<std::string>, std::pair<size_t, std::string>>& GeneratorTopology::at(const std::vector<std::string>& key) {
+		if (topology_.HasState(key)) {
+			return topology_[key];
+		}
+		PCS_INFO(fmt::format(fmt::fg(fmt::color::plum), "[Generator Topology] Materialising State {}", fmt::join(key, ",")));
+		topology_.AddState(key);
+		std::vector<std::string> next = key;
+		for (const auto& successor : Successors(key)) {
+			Apply(next, successor);
+			topology_.AddTransition(key, std::make_pair(successor.resource, *successor.label), next, false);
+			Undo(next, successor);
+		}
+		return topology_[key];
+	}
+
+	SuccessorRange GeneratorTopology::Successors(const std::vector<std::string>& key) const {
+		return SuccessorRange(this, &key);
+	}
+
+	void GeneratorTopology::Apply(std::vector<std::string>& key, const Successor& successor) const {
+		key[successor.resource] = *successor.to;
+		if (successor.IsTransfer()) {
+			key[successor.partner] = *successor.partner_to;
+		}
+	}
+
+	void GeneratorTopology::Undo(std::vector<std::string>& key, const Successor& successor) const {
+		key[successor.resource] = *successor.from;
+		if (successor.IsTransfer()) {
+			key[successor.partner] = *successor.partner_from;
+		}
+	}
+
+	/*
+	 * @return True if the key had not previously been visited
+	 */
+	bool GeneratorTopology::Visit(const std::vector<std::string>& key) {
+		return visited_.insert(key).second;
+	}
+
+	bool GeneratorTopology::Visited(const std::vector<std::string>& key) const {
+		return visited_.contains(key);
+	}
+
+	size_t GeneratorTopology::NumOfVisited() const {
+		return visited_.size();
+	}
+
+	/**
+	 * @brief Depth-first exploration of the whole reachable state space without storing any edges.
+	 * A single global state vector is mutated in place: each Successor is applied when descending and undone when
+	 * backtracking, so no state vector is copied per edge. Uses an explicit stack rather than recursion.
+	 */
+	ExplorationStats GeneratorTopology::Explore() {
+		visited_.clear();
+		ExplorationStats stats = DepthFirst([this](const std::vector<std::string>& key) { return Visit(key); });
+		stats.states = visited_.size();
+		return stats;
+	}
+
+	/**
+	 * @brief Bitstate exploration: as Explore(), but visited states are recorded in a fixed size bit array rather
+	 * than stored. States lost to hash collisions are not explored, see BitStateSet::Coverage() for an estimate.
+	 * The generator's own visited set is left untouched.
+	 */
+	ExplorationStats GeneratorTopology::Explore(BitStateSet& visited) const {
+		ExplorationStats stats = DepthFirst([&visited](const std::vector<std::string>& key) { return visited.Insert(HashStrings(key)); });
+		stats.coverage = visited.Coverage();
+		return stats;
+	}
+
+	/*
+	 * @param visit: marks a state as visited, returning true if it had not been visited before
+	 */
+	template <typename VisitF>
+	ExplorationStats GeneratorTopology::DepthFirst(VisitF&& visit) const {
+		struct Frame {
+			SuccessorIterator it;
+			Successor via;
+		};
+
+		ExplorationStats stats;
+		std::vector<std::string> key = topology_.initial_state();
+		visit(key);
+		stats.states = 1;
+
+		std::vector<Frame> stack;
+		stack.push_back(Frame{ SuccessorIterator(this, &key), Successor() });
+		while (!stack.empty()) {
+			Frame& frame = stack.back();
+			if (frame.it == std::default_sentinel) {
+				if (stack.size() > 1) {
+					Undo(key, frame.via);
+				}
+				stack.pop_back();
+				continue;
+			}
+			Successor successor = *frame.it;
+			++frame.it;
+			++stats.transitions;
+
+			Apply(key, successor);
+			if (visit(key)) {
+				++stats.states;
+				stack.push_back(Frame{ SuccessorIterator(this, &key), successor });
+				stats.max_depth = std::max(stats.max_depth, stack.size() - 1);
+			} else {
+				Undo(key, successor);
+			}
+		}
+		return stats;
+	}
+
+}
\ No newline at end of file
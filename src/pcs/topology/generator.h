@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/topology.h"
+#include "pcs/topology/core.h"
+#include "pcs/common/bitstate.h"
+
+namespace pcs {
+
+	/**
+	 * @brief A topology transition expressed as a delta over the global state: resource `resource` takes `label`
+	 * from local state `from` to `to`. Transfers additionally move the matched `partner` from `partner_from` to `partner_to`.
+	 * All pointers refer into the resource LTSs, so a Successor stays valid whilst the global state vector changes.
+	 */
+	struct Successor {
+		size_t resource = 0;
+		const std::string* label = nullptr;
+		const std::string* from = nullptr;
+		const std::string* to = nullptr;
+
+		size_t partner = 0;
+		const std::string* partner_from = nullptr;
+		const std::string* partner_to = nullptr;
+
+		bool IsTransfer() const {
+			return partner_to != nullptr;
+		}
+	};
+
+	struct ExplorationStats {
+		size_t states = 0;
+		size_t transitions = 0;
+		size_t max_depth = 0;
+		double coverage = 1.0;
+	};
+
+	class GeneratorTopology;
+
+	/**
+	 * @brief Lazily yields the Successors of a single global state, in the same order CompleteTopology adds transitions.
+	 * The global state is referenced rather than copied: it must hold the same value whenever the iterator is advanced.
+	 */
+	class SuccessorIterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Successor;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Successor*;
+		using reference = const Successor&;
+	private:
+		const GeneratorTopology* topology_ = nullptr;
+		const std::vector<std::string>* key_ = nullptr;
+		const std::pair<const std::string, State<std::string, std::string>>* local_ = nullptr;
+		size_t resource_ = 0;
+		size_t transition_ = 0;
+		Successor current_;
+	public:
+		SuccessorIterator() = default;
+		SuccessorIterator(const GeneratorTopology* topology, const std::vector<std::string>* key);
+
+		reference operator*() const;
+		pointer operator->() const;
+		SuccessorIterator& operator++();
+		bool operator==(std::default_sentinel_t) const;
+	private:
+		void Settle();
+	};
+
+	class SuccessorRange {
+	private:
+		SuccessorIterator begin_;
+	public:
+		SuccessorRange(const GeneratorTopology* topology, const std::vector<std::string>* key);
+		SuccessorIterator begin() const;
+		std::default_sentinel_t end() const;
+	};
+
+	/**
+	 * @brief A topology which stores no edges. Outgoing transitions are computed on demand from the resource LTSs
+	 * as Successor deltas; only the set of discovered global states is retained.
+	 */
+	class GeneratorTopology : public ITopology {
+	private:
+		LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>> topology_;
+
+		const std::vector<LTS<std::string, std::string>>& ltss_;
+		std::unordered_set<std::vector<std::string>, boost::hash<std::vector<std::string>>> visited_;
+		std::unordered_map<std::string, std::string> inverse_labels_;
+	public:
+		GeneratorTopology(const std::vector<LTS<std::string, std::string>>& ltss);
+		const LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>& lts() const override;
+		const State<std::vector<std::string>, std::pair<size_t, std::string>>& at(const std::vector<std::string>& key) override;
+		const std::vector<std::string>& initial_state() const override;
+
+		const std::vector<LTS<std::string, std::string>>& resources() const;
+		const std::string& InverseOf(const std::string& transfer_label) const;
+
+		SuccessorRange Successors(const std::vector<std::string>& key) const;
+		void Apply(std::vector<std::string>& key, const Successor& successor) const;
+		void Undo(std::vector<std::string>& key, const Successor& successor) const;
+
+		bool Visit(const std::vector<std::string>& key);
+		bool Visited(const std::vector<std::string>& key) const;
+		size_t NumOfVisited() const;
+
+		ExplorationStats Explore();
+		ExplorationStats Explore(BitStateSet& visited) const;
+	private:
+		template <typename VisitF>
+		ExplorationStats DepthFirst(VisitF&& visit) const;
+	};
+
+}
\ No newline at end of file
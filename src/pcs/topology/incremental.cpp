@@ -32,12 +32,27 @@ namespace pcs {
 		return topology_.initial_state();
 	}
 
+	/**
+	 * @brief Keeps the index up to date with the states expanded so far, and those expanded from now on
+	 */
+	void IncrementalTopology::set_reachability_index(ReachabilityIndex* index) {
+		reachability_ = index;
+		if (reachability_ != nullptr) {
+			for (const auto& [key, state] : topology_.states()) {
+				reachability_->Add(key, state.transitions_);
+			}
+		}
+	}
+
 	const State<std::vector<std::string>, std::pair<size_t, std::string>>& IncrementalTopology::at(const std::vector<std::string>& key) {
 		if (topology_.states().contains(key) == true) {
 			return topology_.states().at(key);
 		} else {
 			topology_.AddState(key);
 			ExpandState(key);
+			if (reachability_ != nullptr) {
+				reachability_->Add(key, topology_.states().at(key).transitions_);
+			}
 			return topology_.states().at(key);
 		}
 	}
@@ -8,6 +8,7 @@
 
 #include "pcs/lts/lts.h"
 #include "pcs/topology/core.h"
+#include "pcs/topology/reachability.h"
 
 namespace pcs {
 
@@ -15,11 +16,14 @@ namespace pcs {
 	private:
 		LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>> topology_;
 		const std::vector<LTS<std::string, std::string>>& ltss_;
+		ReachabilityIndex* reachability_ = nullptr;
 	public:
 		IncrementalTopology(const std::vector<LTS<std::string, std::string>>& ltss);
 		const LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>& lts() const override;
 		const State<std::vector<std::string>, std::pair<size_t, std::string>>& at(const std::vector<std::string>& key) override;
 		const std::vector<std::string>& initial_state() const override;
+
+		void set_reachability_index(ReachabilityIndex* index);
 	private:
 		void ExpandState(const std::vector<std::string>& key);
 
@@ -0,0 +1,330 @@
+#include "pcs/topology/indexed.h"
+
+#include <set>
+#include <map>
+#include <vector>
+#include <string>
+#include <span>
+#include <optional>
+#include <algorithm>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+#include "pcs/operation/parsers/label.h"
+
+namespace pcs {
+
+	// ==========================
+	// Blocks
+	// ==========================
+
+	StateBlock::StateBlock(size_t num_resources)
+		: columns(num_resources) {}
+
+	size_t StateBlock::size() const {
+		return columns.empty() ? 0 : columns.front().size();
+	}
+
+	void StateBlock::clear() {
+		for (auto& column : columns) {
+			column.clear();
+		}
+	}
+
+	void StateBlock::push_back(const uint32_t* key) {
+		for (size_t r = 0; r < columns.size(); ++r) {
+			columns[r].emplace_back(key[r]);
+		}
+	}
+
+	void StateBlock::Row(size_t i, uint32_t* key) const {
+		for (size_t r = 0; r < columns.size(); ++r) {
+			key[r] = columns[r][i];
+		}
+	}
+
+	EdgeBlock::EdgeBlock(size_t num_resources)
+		: targets(num_resources) {}
+
+	size_t EdgeBlock::size() const {
+		return source.size();
+	}
+
+	void EdgeBlock::clear() {
+		source.clear();
+		resource.clear();
+		label.clear();
+		targets.clear();
+	}
+
+	// ==========================
+	// IndexedResources
+	// ==========================
+
+	IndexedResources::IndexedResources(const std::vector<LTS<std::string, std::string>>& ltss) {
+		// Labels, sorted for a deterministic numbering
+		std::set<std::string> labels;
+		for (const auto& lts : ltss) {
+			for (const auto& [name, state] : lts.states()) {
+				for (const auto& t : state.transitions_) {
+					labels.insert(t.label());
+				}
+			}
+		}
+		labels_.assign(labels.begin(), labels.end());
+		std::map<std::string_view, uint32_t> label_ids;
+		for (uint32_t i = 0; i < labels_.size(); ++i) {
+			label_ids.emplace(labels_[i], i);
+		}
+
+		// A transfer matches another label when that label contains its inverse, as in MatchingTransferPartner
+		const size_t num_labels = labels_.size();
+		transfer_.assign(num_labels, 0);
+		matches_.assign(num_labels * num_labels, 0);
+		for (size_t i = 0; i < num_labels; ++i) {
+			if (!IsTransferLabel(labels_[i])) {
+				continue;
+			}
+			transfer_[i] = 1;
+			std::string inverse = StringToTransfer(labels_[i])->Inverse().name();
+			for (size_t j = 0; j < num_labels; ++j) {
+				matches_[i * num_labels + j] = (labels_[j].find(inverse) != std::string::npos);
+			}
+		}
+
+		resources_.resize(ltss.size());
+		for (size_t r = 0; r < ltss.size(); ++r) {
+			const auto& lts = ltss[r];
+			Resource& resource = resources_[r];
+
+			std::set<std::string> names;
+			for (const auto& [name, state] : lts.states()) {
+				names.insert(name);
+			}
+			names.insert(lts.initial_state());
+			resource.names.assign(names.begin(), names.end());
+			for (uint32_t i = 0; i < resource.names.size(); ++i) {
+				resource.ids.emplace(resource.names[i], i);
+			}
+			resource.initial = resource.ids.at(lts.initial_state());
+
+			resource.offsets.reserve(resource.names.size() + 1);
+			for (const auto& name : resource.names) {
+				resource.offsets.emplace_back(static_cast<uint32_t>(resource.transitions.size()));
+				if (!lts.HasState(name)) {
+					continue;
+				}
+				for (const auto& t : lts[name].transitions_) {
+					resource.transitions.emplace_back(LocalTransition{ label_ids.at(t.label()), resource.ids.at(t.to()) });
+				}
+			}
+			resource.offsets.emplace_back(static_cast<uint32_t>(resource.transitions.size()));
+
+			resource.completes.assign(resource.names.size() * num_labels, kNone);
+			for (uint32_t local = 0; local < resource.names.size(); ++local) {
+				for (uint32_t label = 0; label < num_labels; ++label) {
+					if (!transfer_[label]) {
+						continue;
+					}
+					for (uint32_t t = resource.offsets[local]; t < resource.offsets[local + 1]; ++t) {
+						if (Matches(label, resource.transitions[t].label)) {
+							resource.completes[static_cast<size_t>(local) * num_labels + label] = t;
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	size_t IndexedResources::NumOfResources() const {
+		return resources_.size();
+	}
+
+	size_t IndexedResources::NumOfLabels() const {
+		return labels_.size();
+	}
+
+	size_t IndexedResources::NumOfLocalStates(size_t resource) const {
+		return resources_[resource].names.size();
+	}
+
+	const std::string& IndexedResources::LocalName(size_t resource, uint32_t local) const {
+		return resources_[resource].names[local];
+	}
+
+	std::optional<uint32_t> IndexedResources::LocalId(size_t resource, const std::string& name) const {
+		const auto& ids = resources_[resource].ids;
+		auto it = ids.find(name);
+		if (it == ids.end()) {
+			return {};
+		}
+		return it->second;
+	}
+
+	const std::string& IndexedResources::Label(uint32_t label) const {
+		return labels_[label];
+	}
+
+	std::optional<uint32_t> IndexedResources::LabelId(const std::string& label) const {
+		auto it = std::lower_bound(labels_.begin(), labels_.end(), label);
+		if (it == labels_.end() || *it != label) {
+			return {};
+		}
+		return static_cast<uint32_t>(it - labels_.begin());
+	}
+
+	bool IndexedResources::IsTransfer(uint32_t label) const {
+		return transfer_[label] != 0;
+	}
+
+	/*
+	 * @brief Whether `other_label` can complete the transfer `transfer_label`, i.e. contains its inverse
+	 */
+	bool IndexedResources::Matches(uint32_t transfer_label, uint32_t other_label) const {
+		return matches_[static_cast<size_t>(transfer_label) * labels_.size() + other_label] != 0;
+	}
+
+	std::vector<uint32_t> IndexedResources::InitialKey() const {
+		std::vector<uint32_t> key;
+		key.reserve(resources_.size());
+		for (const auto& resource : resources_) {
+			key.emplace_back(resource.initial);
+		}
+		return key;
+	}
+
+	std::vector<std::string> IndexedResources::Names(const uint32_t* key) const {
+		std::vector<std::string> names;
+		names.reserve(resources_.size());
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			names.emplace_back(resources_[r].names[key[r]]);
+		}
+		return names;
+	}
+
+	std::optional<std::vector<uint32_t>> IndexedResources::Ids(const std::vector<std::string>& key) const {
+		if (key.size() != resources_.size()) {
+			return {};
+		}
+		std::vector<uint32_t> ids(key.size());
+		for (size_t r = 0; r < key.size(); ++r) {
+			std::optional<uint32_t> id = LocalId(r, key[r]);
+			if (!id.has_value()) {
+				return {};
+			}
+			ids[r] = *id;
+		}
+		return ids;
+	}
+
+	std::span<const IndexedResources::LocalTransition> IndexedResources::Transitions(size_t resource, uint32_t local) const {
+		const Resource& res = resources_[resource];
+		return std::span<const LocalTransition>(res.transitions.data() + res.offsets[local], res.transitions.data() + res.offsets[local + 1]);
+	}
+
+	/*
+	 * @brief The first other resource, and its first transition from its current local state, which completes the transfer.
+	 */
+	std::optional<std::pair<size_t, const IndexedResources::LocalTransition*>> IndexedResources::Partner(const uint32_t* key, size_t resource,
+		uint32_t label) const {
+		for (size_t r = 0; r < resources_.size(); ++r) {
+			if (r == resource) {
+				continue;
+			}
+			const Resource& other = resources_[r];
+			const uint32_t t = other.completes[static_cast<size_t>(key[r]) * labels_.size() + label];
+			if (t != kNone) {
+				return std::make_pair(r, &other.transitions[t]);
+			}
+		}
+		return {};
+	}
+
+	/**
+	 * @brief Appends the successors of every state in the block to edges, one resource at a time. For each resource
+	 * the enabled transitions of the whole column are gathered first; the target columns are then filled by copying
+	 * the source columns in bulk and patching the moving resource (and transfer partner).
+	 */
+	void IndexedResources::ExpandBatch(const StateBlock& states, EdgeBlock& edges) const {
+		const size_t num_resources = resources_.size();
+		const size_t size = states.size();
+		std::vector<const uint32_t*> columns(num_resources);
+		for (size_t q = 0; q < num_resources; ++q) {
+			columns[q] = states.columns[q].data();
+		}
+		std::vector<uint32_t> sources, labels, tos, partners, partner_tos;
+		for (size_t r = 0; r < num_resources; ++r) {
+			const Resource& resource = resources_[r];
+			const uint32_t* column = columns[r];
+
+			// Gather, sized for the upper bound of every transition being enabled
+			size_t bound = 0;
+			for (uint32_t i = 0; i < size; ++i) {
+				bound += resource.offsets[column[i] + 1] - resource.offsets[column[i]];
+			}
+			sources.resize(bound);
+			labels.resize(bound);
+			tos.resize(bound);
+			partners.resize(bound);
+			partner_tos.resize(bound);
+			size_t count = 0;
+			for (uint32_t i = 0; i < size; ++i) {
+				const uint32_t local = column[i];
+				for (uint32_t t = resource.offsets[local]; t < resource.offsets[local + 1]; ++t) {
+					const LocalTransition& transition = resource.transitions[t];
+					uint32_t partner = kNone, partner_to = kNone;
+					if (transfer_[transition.label]) {
+						// First other resource able to complete the transfer, as in Partner()
+						for (size_t q = 0; q < num_resources; ++q) {
+							if (q == r) {
+								continue;
+							}
+							const Resource& other = resources_[q];
+							const uint32_t u = other.completes[static_cast<size_t>(columns[q][i]) * labels_.size() + transition.label];
+							if (u != kNone) {
+								partner = static_cast<uint32_t>(q);
+								partner_to = other.transitions[u].to;
+								break;
+							}
+						}
+						if (partner == kNone) {
+							continue;
+						}
+					}
+					sources[count] = i;
+					labels[count] = transition.label;
+					tos[count] = transition.to;
+					partners[count] = partner;
+					partner_tos[count] = partner_to;
+					++count;
+				}
+			}
+
+			// Scatter
+			const size_t base = edges.size();
+			edges.source.insert(edges.source.end(), sources.begin(), sources.begin() + count);
+			edges.resource.resize(base + count, static_cast<uint32_t>(r));
+			edges.label.insert(edges.label.end(), labels.begin(), labels.begin() + count);
+			for (size_t q = 0; q < num_resources; ++q) {
+				const uint32_t* from = columns[q];
+				std::vector<uint32_t>& to = edges.targets.columns[q];
+				to.resize(base + count);
+				uint32_t* target = to.data() + base;
+				if (q == r) {
+					std::copy(tos.begin(), tos.begin() + count, target);
+					continue;
+				}
+				for (size_t e = 0; e < count; ++e) {
+					target[e] = from[sources[e]];
+				}
+			}
+			for (size_t e = 0; e < count; ++e) {
+				if (partners[e] != kNone) {
+					edges.targets.columns[partners[e]][base + e] = partner_tos[e];
+				}
+			}
+		}
+	}
+
+}
\ No newline at end of file
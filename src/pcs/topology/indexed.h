@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <span>
+#include <optional>
+#include <unordered_map>
+
+#include "pcs/lts/lts.h"
+
+namespace pcs {
+
+	/**
+	 * @brief A block of global states in structure-of-arrays form: column r holds the local state id of resource r
+	 * for every state in the block.
+	 */
+	struct StateBlock {
+		std::vector<std::vector<uint32_t>> columns;
+
+		StateBlock(size_t num_resources = 0);
+		size_t size() const;
+		void clear();
+		void push_back(const uint32_t* key);
+		void Row(size_t i, uint32_t* key) const;
+	};
+
+	/**
+	 * @brief The edges produced by expanding a StateBlock, also in structure-of-arrays form. Edge e leaves the block
+	 * state source[e] through `label` of `resource` and its target key is held in targets. Edges are grouped by
+	 * resource, so the edges of any single state appear in the same relative order as CompleteTopology adds them.
+	 */
+	struct EdgeBlock {
+		std::vector<uint32_t> source;
+		std::vector<uint32_t> resource;
+		std::vector<uint32_t> label;
+		StateBlock targets;
+
+		EdgeBlock(size_t num_resources = 0);
+		size_t size() const;
+		void clear();
+	};
+
+	/**
+	 * @brief The resource LTSs with local states and labels interned to dense integer ids and transitions stored
+	 * contiguously per local state. Global states can then be handled as arrays of local state ids, which are cheap to
+	 * copy, hash, compare and write to disk.
+	 *
+	 * Local state ids are assigned in lexicographic order of their names, so comparing ids agrees with comparing names.
+	 */
+	class IndexedResources {
+	public:
+		static constexpr uint32_t kNone = UINT32_MAX;
+
+		struct LocalTransition {
+			uint32_t label;
+			uint32_t to;
+		};
+	private:
+		struct Resource {
+			std::vector<std::string> names;
+			std::unordered_map<std::string, uint32_t> ids;
+			std::vector<uint32_t> offsets;
+			std::vector<LocalTransition> transitions;
+			// [local * num_labels + transfer label]: index of the first transition completing that transfer, or kNone
+			std::vector<uint32_t> completes;
+			uint32_t initial = 0;
+		};
+
+		std::vector<Resource> resources_;
+		std::vector<std::string> labels_;
+		std::vector<uint8_t> transfer_;
+		std::vector<uint8_t> matches_;
+	public:
+		IndexedResources(const std::vector<LTS<std::string, std::string>>& ltss);
+
+		size_t NumOfResources() const;
+		size_t NumOfLabels() const;
+		size_t NumOfLocalStates(size_t resource) const;
+
+		const std::string& LocalName(size_t resource, uint32_t local) const;
+		std::optional<uint32_t> LocalId(size_t resource, const std::string& name) const;
+		const std::string& Label(uint32_t label) const;
+		std::optional<uint32_t> LabelId(const std::string& label) const;
+		bool IsTransfer(uint32_t label) const;
+		bool Matches(uint32_t transfer_label, uint32_t other_label) const;
+
+		std::vector<uint32_t> InitialKey() const;
+		std::vector<std::string> Names(const uint32_t* key) const;
+		std::optional<std::vector<uint32_t>> Ids(const std::vector<std::string>& key) const;
+
+		std::span<const LocalTransition> Transitions(size_t resource, uint32_t local) const;
+		std::optional<std::pair<size_t, const LocalTransition*>> Partner(const uint32_t* key, size_t resource, uint32_t label) const;
+
+		void ExpandBatch(const StateBlock& states, EdgeBlock& edges) const;
+
+		/**
+		 * @brief Calls emit(resource, label, to, partner, partner_to) for every outgoing transition of the global state
+		 * `key`, in the same order and with the same transfer matching as CompleteTopology. For non-transfers `partner`
+		 * is kNone.
+		 */
+		template <typename F>
+		void ForEachSuccessor(const uint32_t* key, F&& emit) const {
+			for (size_t r = 0; r < resources_.size(); ++r) {
+				for (const LocalTransition& t : Transitions(r, key[r])) {
+					if (!transfer_[t.label]) {
+						emit(r, t.label, t.to, static_cast<size_t>(kNone), kNone);
+						continue;
+					}
+					auto partner = Partner(key, r, t.label);
+					if (partner.has_value()) {
+						emit(r, t.label, t.to, partner->first, partner->second->to);
+					}
+				}
+			}
+		}
+	};
+
+}
\ No newline at end of file
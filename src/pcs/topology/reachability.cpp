@@ -0,0 +1,280 @@
+#include "pcs/topology/reachability.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/core.h"
+
+namespace pcs {
+
+	ReachabilityIndex::ReachabilityIndex(size_t num_of_resources) : num_of_resources_(num_of_resources) {}
+
+	/**
+	 * @brief Indexes every state of the frozen topology, state ids are the same as the topology's
+	 */
+	ReachabilityIndex::ReachabilityIndex(const FrozenTopology& topology) : num_of_resources_(topology.NumOfResources()) {
+		for (FrozenTopology::StateId s = 0; s < topology.NumOfStates(); ++s) {
+			expanded_[Intern(topology.Key(s))] = true;
+		}
+		for (FrozenTopology::StateId s = 0; s < topology.NumOfStates(); ++s) {
+			for (const auto& edge : topology.Edges(s)) {
+				std::string label(topology.String(edge.label));
+				if (IsTransferLabel(label)) {
+					predecessors_[edge.to].emplace_back(s);
+					successors_[s].emplace_back(edge.to);
+				} else {
+					Seed(edge.resource, label, s);
+				}
+			}
+		}
+		for (size_t target = 0; target < distances_.size(); ++target) {
+			Propagate(target);
+		}
+		Close();
+	}
+
+	/**
+	 * @brief Indexes every state of a topology LTS, such as that of a CompleteTopology. The targets of transfers which
+	 * are not states of the LTS, as in that of a partly expanded IncrementalTopology, are left unknown.
+	 */
+	ReachabilityIndex::ReachabilityIndex(const TopologyLTS& topology) : num_of_resources_(topology.initial_state().size()) {
+		for (const auto& [key, state] : topology.states()) {
+			StateId id = Intern(key);
+			expanded_[id] = true;
+			for (const auto& t : state.transitions_) {
+				if (IsTransferLabel(t.label().second)) {
+					StateId to = Intern(t.to());
+					predecessors_[to].emplace_back(id);
+					successors_[id].emplace_back(to);
+				} else {
+					Seed(t.label().first, t.label().second, id);
+				}
+			}
+		}
+		for (size_t target = 0; target < distances_.size(); ++target) {
+			Propagate(target);
+		}
+		Close();
+	}
+
+	/**
+	 * @brief Adds a state along with its outgoing transitions, and lowers the distances of the states leading to it
+	 * where these now have a shorter path. A state may be added once, after having been the target of other states.
+	 */
+	ReachabilityIndex::StateId ReachabilityIndex::Add(const std::vector<std::string>& key, const TopologyTransitions& transitions) {
+		StateId id = Intern(key);
+		expanded_[id] = true;
+		for (const auto& t : transitions) {
+			if (!IsTransferLabel(t.label().second)) {
+				Seed(t.label().first, t.label().second, id);
+				continue;
+			}
+			StateId to = Intern(t.to());
+			predecessors_[to].emplace_back(id);
+			successors_[id].emplace_back(to);
+			for (auto& distances : distances_) {
+				if (distances[to] != kUnreachable && distances[to] + 1 < distances[id]) {
+					distances[id] = distances[to] + 1;
+				}
+			}
+		}
+		for (size_t target = 0; target < distances_.size(); ++target) {
+			if (distances_[target][id] != kUnreachable) {
+				queue_.assign(1, id);
+				Propagate(target);
+			}
+		}
+		Close(id);
+		return id;
+	}
+
+	/**
+	 * @brief The id of a state which has been added, states only seen as the target of a transfer are unknown
+	 */
+	std::optional<ReachabilityIndex::StateId> ReachabilityIndex::Find(const std::vector<std::string>& key) const {
+		if (auto it = ids_.find(key); it != ids_.end() && expanded_[it->second]) {
+			return it->second;
+		}
+		return {};
+	}
+
+	/**
+	 * @brief The fewest transfers from the state to one where any resource can perform the operation, kUnreachable
+	 * if there is none, or kUnknown while some state reachable from it has not been added
+	 */
+	uint32_t ReachabilityIndex::Distance(StateId state, const std::string& operation) const {
+		return Distance(state, num_of_resources_, operation);
+	}
+
+	/**
+	 * @brief The fewest transfers from the state to one where the resource can perform the operation, kUnreachable
+	 * if there is none, or kUnknown while some state reachable from it has not been added
+	 */
+	uint32_t ReachabilityIndex::Distance(StateId state, size_t resource, const std::string& operation) const {
+		if (!closed_.at(state)) {
+			return kUnknown;
+		}
+		auto it = operations_.find(operation);
+		if (it == operations_.end()) {
+			return kUnreachable;
+		}
+		return distances_[Target(it->second, resource)].at(state);
+	}
+
+	/**
+	 * @brief The resources which can reach a state in which they perform the operation, or might once every state
+	 * reachable from it has been added
+	 */
+	std::vector<size_t> ReachabilityIndex::Capable(StateId state, const std::string& operation) const {
+		std::vector<size_t> resources;
+		for (size_t r = 0; r < num_of_resources_; ++r) {
+			if (Distance(state, r, operation) != kUnreachable) {
+				resources.emplace_back(r);
+			}
+		}
+		return resources;
+	}
+
+	size_t ReachabilityIndex::NumOfStates() const {
+		return predecessors_.size();
+	}
+
+	size_t ReachabilityIndex::NumOfOperations() const {
+		return operations_.size();
+	}
+
+	ReachabilityIndex::StateId ReachabilityIndex::Intern(const std::vector<std::string>& key) {
+		auto [it, inserted] = ids_.try_emplace(key, static_cast<StateId>(predecessors_.size()));
+		if (inserted) {
+			predecessors_.emplace_back();
+			successors_.emplace_back();
+			expanded_.emplace_back(false);
+			closed_.emplace_back(false);
+			visits_.emplace_back(visit_);
+			for (auto& distances : distances_) {
+				distances.emplace_back(kUnreachable);
+			}
+		}
+		return it->second;
+	}
+
+	uint32_t ReachabilityIndex::Operation(const std::string& operation) {
+		auto [it, inserted] = operations_.try_emplace(operation, static_cast<uint32_t>(operations_.size()));
+		if (inserted) {
+			for (size_t r = 0; r <= num_of_resources_; ++r) {
+				distances_.emplace_back(predecessors_.size(), kUnreachable);
+			}
+		}
+		return it->second;
+	}
+
+	size_t ReachabilityIndex::Target(uint32_t operation, size_t resource) const {
+		return operation * (num_of_resources_ + 1) + resource;
+	}
+
+	/*
+	 * @brief Marks the operation as enabled in the state, for the resource and for any resource
+	 */
+	void ReachabilityIndex::Seed(size_t resource, const std::string& operation, StateId state) {
+		uint32_t op = Operation(operation);
+		distances_[Target(op, resource)][state] = 0;
+		distances_[Target(op, num_of_resources_)][state] = 0;
+	}
+
+	/*
+	 * @brief Backward breadth first search over the transfers, from the queued states or, if none are queued, from all
+	 * states where the target is enabled. Only lowers distances, so it also serves incremental updates.
+	 */
+	void ReachabilityIndex::Propagate(size_t target) {
+		std::vector<uint32_t>& distances = distances_[target];
+		if (queue_.empty()) {
+			for (StateId s = 0; s < distances.size(); ++s) {
+				if (distances[s] == 0) {
+					queue_.emplace_back(s);
+				}
+			}
+		}
+		for (size_t i = 0; i < queue_.size(); ++i) {
+			StateId current = queue_[i];
+			for (StateId predecessor : predecessors_[current]) {
+				if (distances[current] + 1 < distances[predecessor]) {
+					distances[predecessor] = distances[current] + 1;
+					queue_.emplace_back(predecessor);
+				}
+			}
+		}
+		queue_.clear();
+	}
+
+	/*
+	 * @brief Marks as closed every state from which no state that has not been added can be reached, by backward
+	 * breadth first search from the states which have not been added
+	 */
+	void ReachabilityIndex::Close() {
+		std::vector<bool> open(predecessors_.size(), false);
+		for (StateId s = 0; s < predecessors_.size(); ++s) {
+			if (!expanded_[s]) {
+				open[s] = true;
+				queue_.emplace_back(s);
+			}
+		}
+		for (size_t i = 0; i < queue_.size(); ++i) {
+			for (StateId predecessor : predecessors_[queue_[i]]) {
+				if (!open[predecessor]) {
+					open[predecessor] = true;
+					queue_.emplace_back(predecessor);
+				}
+			}
+		}
+		queue_.clear();
+		for (StateId s = 0; s < predecessors_.size(); ++s) {
+			closed_[s] = !open[s];
+		}
+	}
+
+	/*
+	 * @brief Closes the states that adding the given one may have closed, which are the state itself and those leading
+	 * to it. A state is closed once a forward search from it, stopping at closed states, meets no state that has not
+	 * been added, in which case all the states it met are closed too. Closed states stay closed, since the transitions
+	 * of a state never change once it has been added.
+	 */
+	void ReachabilityIndex::Close(StateId state) {
+		std::vector<StateId> candidates = { state };
+		std::vector<StateId> met;
+		while (!candidates.empty()) {
+			StateId candidate = candidates.back();
+			candidates.pop_back();
+			if (closed_[candidate] || !expanded_[candidate]) {
+				continue;
+			}
+			++visit_;
+			met.assign(1, candidate);
+			visits_[candidate] = visit_;
+			bool open = false;
+			for (size_t i = 0; i < met.size(); ++i) {
+				if (!expanded_[met[i]]) {
+					open = true;
+					break;
+				}
+				for (StateId successor : successors_[met[i]]) {
+					if (!closed_[successor] && visits_[successor] != visit_) {
+						visits_[successor] = visit_;
+						met.emplace_back(successor);
+					}
+				}
+			}
+			if (open) {
+				continue;
+			}
+			for (StateId s : met) {
+				closed_[s] = true;
+			}
+			for (StateId s : met) {
+				candidates.insert(candidates.end(), predecessors_[s].begin(), predecessors_[s].end());
+			}
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/frozen.h"
+
+namespace pcs {
+
+	/**
+	 * @brief For every topology state, the fewest transfers leading to a state in which an operation is enabled, both
+	 * per resource performing it and for any resource. Built by backward breadth first search from the enabling states,
+	 * so queries are constant time lookups. States can be added one at a time, as IncrementalTopology expands them.
+	 * Successors which have not been added yet are unknown to Find(), and the distances of a state are kUnknown until
+	 * every state its transfers lead to has been added, since until then a shorter path may still turn up.
+	 */
+	class ReachabilityIndex {
+	public:
+		using StateId = uint32_t;
+		using TopologyLTS = LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>;
+		using TopologyTransitions = std::vector<Transition<std::pair<size_t, std::string>, std::vector<std::string>>>;
+
+		static constexpr uint32_t kUnreachable = UINT32_MAX;
+		static constexpr uint32_t kUnknown = UINT32_MAX - 1;
+	private:
+		size_t num_of_resources_;
+		std::unordered_map<std::vector<std::string>, StateId, boost::hash<std::vector<std::string>>> ids_;
+		std::vector<std::vector<StateId>> predecessors_;
+		std::vector<std::vector<StateId>> successors_;
+		// Added along with their transitions, rather than only seen as the target of a transfer
+		std::vector<bool> expanded_;
+		// Every state reachable through transfers has been added, so the distances are final
+		std::vector<bool> closed_;
+		std::vector<uint32_t> visits_;
+		uint32_t visit_ = 0;
+		std::unordered_map<std::string, uint32_t> operations_;
+		// Per (operation, resource) target, and (operation, num_of_resources_) for any resource
+		std::vector<std::vector<uint32_t>> distances_;
+		std::vector<StateId> queue_;
+	public:
+		explicit ReachabilityIndex(size_t num_of_resources);
+		explicit ReachabilityIndex(const FrozenTopology& topology);
+		explicit ReachabilityIndex(const TopologyLTS& topology);
+
+		StateId Add(const std::vector<std::string>& key, const TopologyTransitions& transitions);
+
+		std::optional<StateId> Find(const std::vector<std::string>& key) const;
+		uint32_t Distance(StateId state, const std::string& operation) const;
+		uint32_t Distance(StateId state, size_t resource, const std::string& operation) const;
+		std::vector<size_t> Capable(StateId state, const std::string& operation) const;
+
+		size_t NumOfStates() const;
+		size_t NumOfOperations() const;
+	private:
+		StateId Intern(const std::vector<std::string>& key);
+		uint32_t Operation(const std::string& operation);
+		size_t Target(uint32_t operation, size_t resource) const;
+		void Seed(size_t resource, const std::string& operation, StateId state);
+		void Propagate(size_t target);
+		void Close();
+		void Close(StateId state);
+	};
+
+}
\ No newline at end of file
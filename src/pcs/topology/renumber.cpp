@@ -0,0 +1,165 @@
+#include "pcs/topology/renumber.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <queue>
+#include <memory>
+
+#include "pcs/topology/frozen.h"
+
+namespace pcs {
+
+	using StateId = FrozenTopology::StateId;
+
+	static std::vector<StateId> BreadthFirst(const FrozenTopology& topology, std::vector<bool>& seen) {
+		std::vector<StateId> order;
+		order.reserve(topology.NumOfStates());
+		order.emplace_back(topology.initial_id());
+		seen[topology.initial_id()] = true;
+		for (size_t head = 0; head < order.size(); ++head) {
+			for (const auto& e : topology.Edges(order[head])) {
+				if (!seen[e.to]) {
+					seen[e.to] = true;
+					order.emplace_back(e.to);
+				}
+			}
+		}
+		return order;
+	}
+
+	/*
+	 * @brief Pre-order depth first search with an explicit stack, visiting edges in their stored order.
+	 */
+	static std::vector<StateId> DepthFirst(const FrozenTopology& topology, std::vector<bool>& seen) {
+		std::vector<StateId> order;
+		order.reserve(topology.NumOfStates());
+		std::vector<std::pair<StateId, size_t>> stack;
+		stack.emplace_back(topology.initial_id(), 0);
+		seen[topology.initial_id()] = true;
+		order.emplace_back(topology.initial_id());
+		while (!stack.empty()) {
+			auto& [state, next] = stack.back();
+			auto edges = topology.Edges(state);
+			if (next == edges.size()) {
+				stack.pop_back();
+				continue;
+			}
+			StateId to = edges[next++].to;
+			if (!seen[to]) {
+				seen[to] = true;
+				order.emplace_back(to);
+				stack.emplace_back(to, 0);
+			}
+		}
+		return order;
+	}
+
+	/*
+	 * @brief Cuthill-McKee over the symmetrised graph, one component at a time starting from a minimum degree state,
+	 * visiting neighbours in increasing degree. The caller reverses the result.
+	 */
+	static std::vector<StateId> CuthillMcKee(const FrozenTopology& topology, std::vector<bool>& seen) {
+		const size_t num_states = topology.NumOfStates();
+		std::vector<std::vector<StateId>> neighbours(num_states);
+		for (StateId s = 0; s < num_states; ++s) {
+			for (const auto& e : topology.Edges(s)) {
+				if (e.to != s) {
+					neighbours[s].emplace_back(e.to);
+					neighbours[e.to].emplace_back(s);
+				}
+			}
+		}
+		for (auto& adjacent : neighbours) {
+			std::sort(adjacent.begin(), adjacent.end());
+			adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+		}
+		auto by_degree = [&](StateId a, StateId b) {
+			return neighbours[a].size() != neighbours[b].size() ? neighbours[a].size() < neighbours[b].size() : a < b;
+		};
+		std::vector<StateId> starts(num_states);
+		std::iota(starts.begin(), starts.end(), 0);
+		std::sort(starts.begin(), starts.end(), by_degree);
+
+		std::vector<StateId> order;
+		order.reserve(num_states);
+		std::vector<StateId> adjacent;
+		for (StateId start : starts) {
+			if (seen[start]) {
+				continue;
+			}
+			seen[start] = true;
+			order.emplace_back(start);
+			for (size_t head = order.size() - 1; head < order.size(); ++head) {
+				adjacent.clear();
+				for (StateId n : neighbours[order[head]]) {
+					if (!seen[n]) {
+						seen[n] = true;
+						adjacent.emplace_back(n);
+					}
+				}
+				std::sort(adjacent.begin(), adjacent.end(), by_degree);
+				order.insert(order.end(), adjacent.begin(), adjacent.end());
+			}
+		}
+		return order;
+	}
+
+	/**
+	 * @brief A permutation of the state ids (order[new id] = old id) in the requested order. States which cannot be
+	 * reached from the initial state keep their relative order at the end.
+	 */
+	std::vector<StateId> StateOrdering(const FrozenTopology& topology, StateOrder order) {
+		std::vector<bool> seen(topology.NumOfStates(), false);
+		std::vector<StateId> ordering;
+		switch (order) {
+		case StateOrder::kBreadthFirst:
+			ordering = BreadthFirst(topology, seen);
+			break;
+		case StateOrder::kDepthFirst:
+			ordering = DepthFirst(topology, seen);
+			break;
+		case StateOrder::kReverseCuthillMcKee:
+			ordering = CuthillMcKee(topology, seen);
+			std::reverse(ordering.begin(), ordering.end());
+			break;
+		}
+		for (StateId s = 0; s < topology.NumOfStates(); ++s) {
+			if (!seen[s]) {
+				ordering.emplace_back(s);
+			}
+		}
+		return ordering;
+	}
+
+	/**
+	 * @brief Lays the topology out again so that states which are adjacent in the graph are close in memory, which
+	 * improves cache behaviour of searches that follow edges (e.g. transfer chains in the controller).
+	 */
+	std::unique_ptr<FrozenTopology> Renumber(const FrozenTopology& topology, StateOrder order) {
+		std::vector<StateId> ordering = StateOrdering(topology, order);
+		return topology.Permute(ordering);
+	}
+
+	LocalityStats MeasureLocality(const FrozenTopology& topology, size_t window) {
+		LocalityStats stats;
+		size_t near = 0;
+		double total = 0.0;
+		for (StateId s = 0; s < topology.NumOfStates(); ++s) {
+			for (const auto& e : topology.Edges(s)) {
+				size_t distance = e.to > s ? e.to - s : s - e.to;
+				total += static_cast<double>(distance);
+				stats.bandwidth = std::max(stats.bandwidth, distance);
+				if (distance <= window) {
+					++near;
+				}
+			}
+		}
+		if (topology.NumOfTransitions() > 0) {
+			stats.mean_distance = total / static_cast<double>(topology.NumOfTransitions());
+			stats.near_fraction = static_cast<double>(near) / static_cast<double>(topology.NumOfTransitions());
+		}
+		return stats;
+	}
+
+}
\ No newline at end of file
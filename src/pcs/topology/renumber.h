@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#include "pcs/topology/frozen.h"
+
+namespace pcs {
+
+	/**
+	 * @brief State orderings for Renumber(). Breadth and depth first follow the directed edges from the initial
+	 * state in edge order; reverse Cuthill-McKee works on the undirected graph and minimises the id distance
+	 * between neighbouring states.
+	 */
+	enum class StateOrder {
+		kBreadthFirst,
+		kDepthFirst,
+		kReverseCuthillMcKee
+	};
+
+	/**
+	 * @brief How far apart in memory the endpoints of edges are, measured in state ids.
+	 * @param mean_distance: mean |from - to| over all edges
+	 * @param bandwidth: maximum |from - to|
+	 * @param near_fraction: fraction of edges with |from - to| within the window given to MeasureLocality()
+	 */
+	struct LocalityStats {
+		double mean_distance = 0.0;
+		size_t bandwidth = 0;
+		double near_fraction = 0.0;
+	};
+
+	std::vector<FrozenTopology::StateId> StateOrdering(const FrozenTopology& topology, StateOrder order);
+	std::unique_ptr<FrozenTopology> Renumber(const FrozenTopology& topology, StateOrder order);
+	LocalityStats MeasureLocality(const FrozenTopology& topology, size_t window = 16);
+
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "pcs/topology/static.h"
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/incremental.h"
+
+namespace pcs {
+
+	using StaticFactory = std::unique_ptr<ITopology>(*)(const std::vector<LTS<std::string, std::string>>&, bool);
+
+	template <size_t N>
+	static std::unique_ptr<ITopology> MakeStatic(const std::vector<LTS<std::string, std::string>>& ltss, bool incremental) {
+		return std::make_unique<StaticTopology<N>>(ltss, incremental);
+	}
+
+	template <size_t... I>
+	static constexpr std::array<StaticFactory, sizeof...(I)> StaticFactories(std::index_sequence<I...>) {
+		return { &MakeStatic<I + 1>... };
+	}
+
+	/**
+	 * @brief Builds a StaticTopology<N> for N = the number of resources, or the dynamic topology of the same kind when
+	 * there are more than kMaxStaticResources (or no) resources.
+	 * @param incremental: expand states on demand rather than computing the complete topology
+	 */
+	std::unique_ptr<ITopology> MakeStaticTopology(const std::vector<LTS<std::string, std::string>>& ltss, bool incremental) {
+		static constexpr std::array<StaticFactory, kMaxStaticResources> factories = StaticFactories(std::make_index_sequence<kMaxStaticResources>());
+		if (ltss.empty() || ltss.size() > kMaxStaticResources) {
+			if (incremental) {
+				return std::make_unique<IncrementalTopology>(ltss);
+			}
+			return std::make_unique<CompleteTopology>(ltss);
+		}
+		return factories[ltss.size() - 1](ltss, incremental);
+	}
+
+}
\ No newline at end of file
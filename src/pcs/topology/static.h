@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
+#include <span>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/topology.h"
+#include "pcs/topology/indexed.h"
+#include "pcs/common/hash.h"
+
+namespace pcs {
+
+	/**
+	 * @brief A topology over exactly N resources whose global states are std::array<uint32_t, N> of interned local
+	 * state ids, so states and edges are stored without any per-key heap allocation and key hashing, comparison and
+	 * the per-resource expansion loop are unrolled for the fixed N.
+	 *
+	 * Either computes the complete topology up front, or expands states on demand like IncrementalTopology. ITopology
+	 * queries materialise string keyed LTS states lazily. Use MakeStaticTopology() to dispatch on the resource count.
+	 */
+	template <size_t N>
+	class StaticTopology : public ITopology {
+	public:
+		using Key = std::array<uint32_t, N>;
+		using StateId = uint32_t;
+		using TopologyLTS = LTS<std::vector<std::string>, std::pair<size_t, std::string>, boost::hash<std::vector<std::string>>>;
+
+		struct Edge {
+			StateId to;
+			uint32_t resource;
+			uint32_t label;
+		};
+
+		struct KeyHash {
+			size_t operator()(const Key& key) const {
+				uint64_t hash = kFnvOffsetBasis;
+				for (size_t i = 0; i < N; ++i) {
+					hash = (hash ^ key[i]) * kFnvPrime;
+				}
+				return static_cast<size_t>(Mix64(hash));
+			}
+		};
+	private:
+		static constexpr uint32_t kUnexpanded = UINT32_MAX;
+
+		IndexedResources indexed_;
+		std::vector<Key> keys_;
+		std::unordered_map<Key, StateId, KeyHash> ids_;
+		std::vector<Edge> edges_;
+		std::vector<std::pair<uint32_t, uint32_t>> ranges_;
+		bool incremental_;
+
+		mutable TopologyLTS topology_;
+	public:
+		StaticTopology(const std::vector<LTS<std::string, std::string>>& ltss, bool incremental)
+			: indexed_(ltss), incremental_(incremental) {
+			if (indexed_.NumOfResources() != N) {
+				throw std::invalid_argument("[Static Topology] Expected " + std::to_string(N) + " resources");
+			}
+			Key initial;
+			std::vector<uint32_t> initial_ids = indexed_.InitialKey();
+			std::copy(initial_ids.begin(), initial_ids.end(), initial.begin());
+			Insert(initial);
+			topology_.set_initial_state(indexed_.Names(initial.data()), false);
+			if (incremental_) {
+				Expand(0);
+				return;
+			}
+			// Ids are assigned in discovery order, so expanding them in order is a breadth first search
+			for (StateId id = 0; id < keys_.size(); ++id) {
+				Expand(id);
+			}
+		}
+
+		/*
+		 * @brief All states for a complete topology, only the expanded states for an incremental one.
+		 */
+		const TopologyLTS& lts() const override {
+			for (StateId id = 0; id < keys_.size(); ++id) {
+				if (ranges_[id].first != kUnexpanded) {
+					Materialise(id);
+				}
+			}
+			return topology_;
+		}
+
+		const std::vector<std::string>& initial_state() const override {
+			return topology_.initial_state();
+		}
+
+		/*
+		 * @exception Throws std::out_of_range for keys which are not states of the resources (or not reachable,
+		 *            for a complete topology)
+		 */
+		const State<std::vector<std::string>, std::pair<size_t, std::string>>& at(const std::vector<std::string>& key) override {
+			std::optional<std::vector<uint32_t>> ids = indexed_.Ids(key);
+			if (!ids.has_value()) {
+				throw std::out_of_range("[Static Topology] Unknown local state");
+			}
+			Key k;
+			std::copy(ids->begin(), ids->end(), k.begin());
+			std::optional<StateId> id = Find(k);
+			if (!id.has_value()) {
+				if (!incremental_) {
+					throw std::out_of_range("[Static Topology] State is not part of the topology");
+				}
+				id = Insert(k);
+			}
+			Expand(*id);
+			return Materialise(*id);
+		}
+
+		const IndexedResources& indexed() const {
+			return indexed_;
+		}
+
+		size_t NumOfStates() const {
+			return keys_.size();
+		}
+
+		size_t NumOfTransitions() const {
+			return edges_.size();
+		}
+
+		const Key& key(StateId id) const {
+			return keys_[id];
+		}
+
+		std::optional<StateId> Find(const Key& key) const {
+			auto it = ids_.find(key);
+			if (it == ids_.end()) {
+				return {};
+			}
+			return it->second;
+		}
+
+		/*
+		 * @brief The outgoing edges of a state, expanding it first if needed.
+		 */
+		std::span<const Edge> Expand(StateId id) {
+			if (ranges_[id].first == kUnexpanded) {
+				const uint32_t begin = static_cast<uint32_t>(edges_.size());
+				ExpandResources(id, std::make_index_sequence<N>());
+				ranges_[id] = { begin, static_cast<uint32_t>(edges_.size()) };
+			}
+			return std::span<const Edge>(edges_.data() + ranges_[id].first, edges_.data() + ranges_[id].second);
+		}
+	private:
+		StateId Insert(const Key& key) {
+			auto [it, inserted] = ids_.try_emplace(key, static_cast<StateId>(keys_.size()));
+			if (inserted) {
+				keys_.emplace_back(key);
+				ranges_.emplace_back(kUnexpanded, kUnexpanded);
+			}
+			return it->second;
+		}
+
+		template <size_t... I>
+		void ExpandResources(StateId id, std::index_sequence<I...>) {
+			(ExpandResource<I>(id), ...);
+		}
+
+		/*
+		 * @brief Appends the edges of one resource, in the same order and with the same transfer matching as CompleteTopology.
+		 */
+		template <size_t R>
+		void ExpandResource(StateId id) {
+			for (const IndexedResources::LocalTransition& t : indexed_.Transitions(R, keys_[id][R])) {
+				Key next = keys_[id];
+				next[R] = t.to;
+				if (indexed_.IsTransfer(t.label)) {
+					auto partner = indexed_.Partner(keys_[id].data(), R, t.label);
+					if (!partner.has_value()) {
+						continue;
+					}
+					next[partner->first] = partner->second->to;
+				}
+				edges_.push_back(Edge{ Insert(next), static_cast<uint32_t>(R), t.label });
+			}
+		}
+
+		const State<std::vector<std::string>, std::pair<size_t, std::string>>& Materialise(StateId id) const {
+			std::vector<std::string> names = indexed_.Names(keys_[id].data());
+			if (topology_.HasState(names)) {
+				return topology_[names];
+			}
+			topology_.AddState(names);
+			for (size_t i = ranges_[id].first; i < ranges_[id].second; ++i) {
+				const Edge& e = edges_[i];
+				topology_.AddTransition(names, std::make_pair(static_cast<size_t>(e.resource), indexed_.Label(e.label)),
+					indexed_.Names(keys_[e.to].data()), false);
+			}
+			return topology_[names];
+		}
+	};
+
+	/**
+	 * @brief Largest resource count with a StaticTopology specialisation, larger environments fall back to the
+	 * string keyed CompleteTopology or IncrementalTopology.
+	 */
+	inline constexpr size_t kMaxStaticResources = 16;
+
+	std::unique_ptr<ITopology> MakeStaticTopology(const std::vector<LTS<std::string, std::string>>& ltss, bool incremental);
+
+}
\ No newline at end of file
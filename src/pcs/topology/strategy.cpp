@@ -0,0 +1,123 @@
+#include "pcs/topology/strategy.h"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <vector>
+#include <string>
+#include <unordered_set>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/topology/generator.h"
+#include "pcs/common/log.h"
+
+namespace pcs {
+
+	const char* ToString(TopologyStrategy strategy) {
+		switch (strategy) {
+			case TopologyStrategy::kComplete:
+				return "Complete";
+			case TopologyStrategy::kIncremental:
+				return "Incremental";
+			case TopologyStrategy::kGenerator:
+				return "Generator";
+		}
+		return "Unknown";
+	}
+
+	/*
+	 * @brief Explores up to `limit` states breadth first, counting their successors.
+	 */
+	static void SampleBranching(const std::vector<LTS<std::string, std::string>>& ltss, size_t limit, StrategyStats& stats) {
+		GeneratorTopology generator(ltss);
+		std::unordered_set<std::vector<std::string>, boost::hash<std::vector<std::string>>> seen = { generator.initial_state() };
+		std::deque<std::vector<std::string>> queue = { generator.initial_state() };
+		size_t transitions = 0;
+		while (!queue.empty() && stats.sampled_states < limit) {
+			std::vector<std::string> key = std::move(queue.front());
+			queue.pop_front();
+			++stats.sampled_states;
+			for (const Successor& successor : generator.Successors(key)) {
+				++transitions;
+				std::vector<std::string> next = key;
+				generator.Apply(next, successor);
+				if (seen.insert(next).second) {
+					queue.emplace_back(std::move(next));
+				}
+			}
+		}
+		stats.exact = queue.empty();
+		stats.branching_factor = (stats.sampled_states == 0) ? 0.0 : static_cast<double>(transitions) / stats.sampled_states;
+		if (stats.exact) {
+			stats.estimated_states = static_cast<double>(stats.sampled_states);
+			stats.estimated_transitions = static_cast<double>(transitions);
+		}
+	}
+
+	/*
+	 * @brief The number of resources offering at least one of the recipe's operations.
+	 */
+	static size_t Footprint(const std::vector<LTS<std::string, std::string>>& ltss, const Recipe& recipe) {
+		std::set<std::string> operations;
+		for (const auto& [name, state] : recipe.lts().states()) {
+			for (const auto& t : state.transitions_) {
+				for (const auto& tuple : t.label().sequential) {
+					operations.insert(std::get<0>(tuple).name());
+				}
+				for (const auto& tuple : t.label().parallel) {
+					operations.insert(std::get<0>(tuple).name());
+				}
+			}
+		}
+		size_t footprint = 0;
+		for (const auto& lts : ltss) {
+			bool offers = std::any_of(lts.states().begin(), lts.states().end(), [&](const auto& pair) {
+				return std::any_of(pair.second.transitions_.begin(), pair.second.transitions_.end(),
+					[&](const auto& t) { return operations.contains(t.label()); });
+			});
+			footprint += offers ? 1 : 0;
+		}
+		return footprint;
+	}
+
+	/**
+	 * @brief Estimates the size of the topology and picks how to compute it. The product of the resource state counts
+	 * bounds the number of states, unless a breadth first sample from the initial state exhausts the topology first.
+	 * Small topologies are computed completely, large ones incrementally, and ones whose edges would not fit are
+	 * left to the generator which stores no edges.
+	 */
+	StrategyStats ChooseStrategy(const std::vector<LTS<std::string, std::string>>& ltss, const Recipe& recipe, const StrategyOpts& opts) {
+		StrategyStats stats;
+		stats.resources = ltss.size();
+		stats.footprint = Footprint(ltss, recipe);
+		SampleBranching(ltss, opts.sample_states, stats);
+		if (!stats.exact) {
+			stats.estimated_states = 1.0;
+			for (const auto& lts : ltss) {
+				stats.estimated_states *= static_cast<double>(lts.NumOfStates());
+			}
+			stats.estimated_transitions = stats.estimated_states * stats.branching_factor;
+		}
+
+		double footprint = (stats.resources == 0) ? 1.0 : static_cast<double>(std::max<size_t>(stats.footprint, 1)) / stats.resources;
+		double complete_limit = static_cast<double>(opts.complete_states) * footprint;
+		std::string estimate = fmt::format("{} {:.0f} states and {:.0f} transitions (branching factor {:.2f} over {} sampled states)",
+			stats.exact ? "exactly" : "at most", stats.estimated_states, stats.estimated_transitions, stats.branching_factor, stats.sampled_states);
+		if (stats.estimated_states <= complete_limit) {
+			stats.strategy = TopologyStrategy::kComplete;
+			stats.reason = fmt::format("{}, within the complete limit of {:.0f} states for a recipe using {} of {} resources",
+				estimate, complete_limit, stats.footprint, stats.resources);
+		} else if (stats.estimated_transitions > static_cast<double>(opts.generator_transitions)) {
+			stats.strategy = TopologyStrategy::kGenerator;
+			stats.reason = fmt::format("{}, more transitions than the limit of {} to store", estimate, opts.generator_transitions);
+		} else {
+			stats.strategy = TopologyStrategy::kIncremental;
+			stats.reason = fmt::format("{}, above the complete limit of {:.0f} states for a recipe using {} of {} resources",
+				estimate, complete_limit, stats.footprint, stats.resources);
+		}
+		return stats;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+#include "pcs/product/recipe.h"
+
+namespace pcs {
+
+	/**
+	 * @brief How Environment computes its topology: all of it up front, on demand with stored edges, or on demand
+	 * from the resources without storing any edges.
+	 */
+	enum class TopologyStrategy {
+		kComplete,
+		kIncremental,
+		kGenerator
+	};
+
+	/**
+	 * @brief Thresholds for ChooseStrategy().
+	 * @param complete_states: estimated states up to which the complete topology is computed, scaled by the fraction of
+	 *                         resources in the recipe's footprint since a recipe touching few resources visits few states
+	 * @param generator_transitions: estimated transitions beyond which edges are no longer stored at all
+	 * @param sample_states: number of states explored breadth first from the initial state to sample the branching factor
+	 */
+	struct StrategyOpts {
+		size_t complete_states = 1 << 16;
+		size_t generator_transitions = 1 << 24;
+		size_t sample_states = 256;
+	};
+
+	/**
+	 * @brief The chosen strategy and the figures it was based on.
+	 * @param exact: whether the sample exhausted the topology, in which case estimated_states is its actual size
+	 *               rather than the product of the resource state counts
+	 * @param reason: human readable reasoning behind the choice
+	 */
+	struct StrategyStats {
+		TopologyStrategy strategy = TopologyStrategy::kComplete;
+		double estimated_states = 0.0;
+		double estimated_transitions = 0.0;
+		bool exact = false;
+		double branching_factor = 0.0;
+		size_t sampled_states = 0;
+		size_t footprint = 0;
+		size_t resources = 0;
+		std::string reason;
+	};
+
+	const char* ToString(TopologyStrategy strategy);
+	StrategyStats ChooseStrategy(const std::vector<LTS<std::string, std::string>>& ltss, const Recipe& recipe, const StrategyOpts& opts = {});
+
+}
\ No newline at end of file
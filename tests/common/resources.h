@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/environment/environment.h"
+
+/*
+ * @brief Reads Resource1.txt ... Resource<count>.txt from the given directory
+ */
+inline std::vector<pcs::LTS<std::string, std::string>> LoadResources(const std::string& directory, size_t count) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss(count);
+	for (size_t i = 0; i < count; ++i) {
+		pcs::ReadFromFile(ltss[i], directory + "/Resource" + std::to_string(i + 1) + ".txt");
+	}
+	return ltss;
+}
+
+/*
+ * @brief Builds an environment from Resource1.txt ... Resource<count>.txt, computing its complete topology if asked to
+ */
+inline pcs::Environment LoadMachine(const std::string& directory, size_t count, bool complete = true) {
+	pcs::Environment machine;
+	for (size_t i = 1; i <= count; ++i) {
+		machine.AddResource(directory + "/Resource" + std::to_string(i) + ".txt", false);
+	}
+	if (complete) {
+		machine.Complete();
+	}
+	return machine;
+}
+
+/*
+ * @brief Returns an empty scratch directory under the system temporary directory
+ */
+inline std::filesystem::path CleanDirectory(const std::string& name) {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "pcs-tests" / name;
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	return directory;
+}
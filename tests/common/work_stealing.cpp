@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "pcs/common/work_stealing.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingPool, RunsEveryTask) {
+	pcs::WorkStealingPool pool(4);
+	std::atomic<size_t> leaves = 0;
+	std::function<void(size_t)> split = [&](size_t depth) {
+		if (depth == 10) {
+			++leaves;
+			return;
+		}
+		pool.Spawn([&, depth](size_t) { split(depth + 1); });
+		pool.Spawn([&, depth](size_t) { split(depth + 1); });
+	};
+	pool.Run([&](size_t) { split(0); });
+	EXPECT_EQ(leaves, 1024);
+
+	// The workers are kept between runs
+	pool.Run([&](size_t) { split(5); });
+	EXPECT_EQ(leaves, 1024 + 32);
+}
+
+TEST(WorkStealingPool, SingleWorker) {
+	pcs::WorkStealingPool pool(1);
+	std::vector<size_t> order;
+	pool.Run([&](size_t worker) {
+		for (size_t i = 0; i < 3; ++i) {
+			pool.Spawn([&, i](size_t worker) { order.emplace_back(i); EXPECT_EQ(worker, 0); });
+		}
+	});
+	EXPECT_EQ(order, std::vector<size_t>({ 2, 1, 0 })); // Depth first from the back of the deque
+	EXPECT_EQ(pool.NumOfSteals(), 0);
+}
+
+TEST(WorkStealingPool, StealsFromBusyWorkers) {
+	pcs::WorkStealingPool pool(4);
+	std::vector<std::atomic<size_t>> ran(pool.size());
+	pool.Run([&](size_t) {
+		for (size_t i = 0; i < 64; ++i) {
+			pool.Spawn([&](size_t worker) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				++ran[worker];
+			});
+		}
+	});
+	size_t total = 0;
+	for (const auto& count : ran) {
+		total += count;
+	}
+	EXPECT_EQ(total, 64);
+	EXPECT_GT(pool.NumOfSteals(), 0);
+	EXPECT_LE(pool.NumOfSteals(), 64);
+}
+
+TEST(WorkStealingPool, RethrowsAfterRemainingTasks) {
+	pcs::WorkStealingPool pool(3);
+	std::atomic<size_t> ran = 0;
+	EXPECT_THROW(pool.Run([&](size_t) {
+		for (size_t i = 0; i < 16; ++i) {
+			pool.Spawn([&, i](size_t) {
+				++ran;
+				if (i == 3) {
+					throw std::runtime_error("task failed");
+				}
+			});
+		}
+	}), std::runtime_error);
+	EXPECT_EQ(ran, 16);
+
+	// The error does not carry over into the next run
+	EXPECT_NO_THROW(pool.Run([&](size_t) { ++ran; }));
+	EXPECT_EQ(ran, 17);
+}
+
+TEST(WorkStealingPool, NestedPools) {
+	pcs::WorkStealingPool outer(2);
+	std::atomic<size_t> inner_tasks = 0;
+	outer.Run([&](size_t) {
+		for (size_t i = 0; i < 4; ++i) {
+			outer.Spawn([&](size_t) {
+				pcs::WorkStealingPool inner(2);
+				inner.Run([&](size_t) {
+					for (size_t j = 0; j < 8; ++j) {
+						inner.Spawn([&](size_t) { ++inner_tasks; });
+					}
+				});
+			});
+		}
+	});
+	EXPECT_EQ(inner_tasks, 32);
+
+	// A task cannot wait on its own pool
+	EXPECT_THROW(outer.Run([&](size_t) { outer.Run([](size_t) {}); }), std::logic_error);
+}
@@ -0,0 +1,352 @@
+#include <gtest/gtest.h>
+#include "pcs/controller/controller.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "pcs/lts/lts.h"
+#include "pcs/product/recipe.h"
+#include "pcs/environment/environment.h"
+
+#include "common/resources.h"
+
+TEST(Controller, MemoisationMatchesSearch) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller memoised(&machine, machine.topology(), &recipe);
+		pcs::Controller searched(&machine, machine.topology(), &recipe, { .memoise = false });
+		EXPECT_EQ(**memoised.Generate(), **searched.Generate());
+		EXPECT_GT(memoised.transpositions().misses(), 0);
+		EXPECT_EQ(searched.transpositions().size(), 0);
+	}
+}
+
+TEST(Controller, MemoisesRepeatedOperations) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/branches.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &recipe);
+	auto lts = controller.Generate();
+	EXPECT_EQ(controller.transpositions().misses(), 1);
+	EXPECT_EQ(controller.transpositions().hits(), 1);
+	EXPECT_EQ(controller.transpositions().size(), 1);
+	EXPECT_EQ((*lts)->NumOfTransitions(), 4); // A transfer and the polish, replayed for the second branch
+}
+
+TEST(Controller, CutsTransferCycles) {
+	// The resources can pass parts back and forth forever, but neither can weld
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &recipe);
+	auto lts = controller.Generate();
+	EXPECT_EQ((*lts)->NumOfTransitions(), 0);
+	EXPECT_EQ(controller.transpositions().size(), 1);
+}
+
+TEST(Controller, BitstateSearch) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller exact(&machine, machine.topology(), &recipe);
+		pcs::Controller bitstate(&machine, machine.topology(), &recipe);
+		bitstate.set_bitstate(1 << 20);
+		EXPECT_EQ(**bitstate.Generate(), **exact.Generate());
+		ASSERT_NE(bitstate.bitstate(), nullptr);
+		EXPECT_GT(bitstate.bitstate()->NumOfInserted(), 0);
+		EXPECT_GT(bitstate.bitstate()->Coverage(), 0.99);
+	}
+
+	// A failed bitstate search may be a false positive, so it is not memoised as unrealisable
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+	pcs::Controller controller(&machine, machine.topology(), &recipe);
+	controller.set_bitstate(64);
+	EXPECT_EQ((*controller.Generate())->NumOfTransitions(), 0);
+	EXPECT_EQ(controller.transpositions().size(), 0);
+}
+
+static size_t NumOfTransfers(const pcs::LTS<std::vector<std::string>, std::vector<std::string>, boost::hash<std::vector<std::string>>>& lts) {
+	size_t transfers = 0;
+	for (const auto& [key, state] : lts.states()) {
+		for (const auto& t : state.transitions_) {
+			transfers += std::count_if(t.label().begin(), t.label().end(), [](const std::string& label) { return label.starts_with("out:"); });
+		}
+	}
+	return transfers;
+}
+
+TEST(Controller, ShortestPlans) {
+	// A single operation several transfers away from the initial state, for which a shortest plan is at most as long as any other
+	pcs::Environment machine = LoadMachine("../../data/hinge", 5);
+	pcs::Recipe recipe("../../tests/controller/testdata/press.json");
+
+	pcs::Controller depth_first(&machine, machine.topology(), &recipe);
+	pcs::Controller breadth_first(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kBreadthFirst });
+	pcs::Controller a_star(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kAStar });
+	size_t dfs = NumOfTransfers(**depth_first.Generate());
+	size_t bfs = NumOfTransfers(**breadth_first.Generate());
+	size_t guided = NumOfTransfers(**a_star.Generate());
+
+	EXPECT_GT(bfs, 0);
+	EXPECT_LE(bfs, dfs);
+	EXPECT_EQ(guided, bfs);
+	EXPECT_LT(a_star.NumOfExpansions(), breadth_first.NumOfExpansions());
+}
+
+TEST(Controller, ShortestPlansOverRecipes) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller breadth_first(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kBreadthFirst });
+		pcs::Controller a_star(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kAStar });
+		EXPECT_EQ(NumOfTransfers(**a_star.Generate()), NumOfTransfers(**breadth_first.Generate()));
+		EXPECT_LE(a_star.NumOfExpansions(), breadth_first.NumOfExpansions());
+	}
+}
+
+TEST(Controller, ShortestPlanPrunesUnreachableOperations) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kAStar });
+	EXPECT_EQ((*controller.Generate())->NumOfTransitions(), 0);
+	EXPECT_EQ(controller.NumOfExpansions(), 0);
+}
+
+TEST(Controller, ReachabilityIndexOverIncrementalTopology) {
+	// States the incremental topology has not expanded yet must not be taken for dead ends
+	for (const std::string folder : { "hinge", "pad" }) {
+		for (pcs::SearchMode search : { pcs::SearchMode::kDepthFirst, pcs::SearchMode::kAStar }) {
+			pcs::Environment machine = LoadMachine("../../data/" + folder, 5, false);
+			pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+			std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/" + folder, 5);
+
+			pcs::IncrementalTopology plain_topology(ltss);
+			pcs::Controller plain(&machine, &plain_topology, &recipe, { .search = search });
+			pcs::IncrementalTopology indexed_topology(ltss);
+			pcs::ReachabilityIndex index(ltss.size());
+			indexed_topology.set_reachability_index(&index);
+			pcs::Controller indexed(&machine, &indexed_topology, &recipe, { .search = search });
+			indexed.set_reachability_index(&index);
+
+			pcs::Realisability expected = plain.Decide();
+			pcs::Realisability result = indexed.Decide();
+			EXPECT_EQ(result.realisable, expected.realisable) << folder;
+			EXPECT_EQ(result.operation, expected.operation) << folder;
+			EXPECT_EQ(result.from, expected.from) << folder;
+			EXPECT_EQ(NumOfTransfers(**indexed.Generate()), NumOfTransfers(**plain.Generate())) << folder;
+		}
+	}
+}
+
+TEST(Controller, CheapestPlans) {
+	// Resource1 can press right after loading, but handing the part to Resource2 and pressing there is cheaper
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/costs", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/press.json");
+
+	pcs::Controller first(&machine, machine.topology(), &recipe);
+	pcs::Controller total(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kCheapest });
+	pcs::Controller makespan(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kCheapest,
+		.objective = pcs::CostObjective::kMakespan });
+	EXPECT_EQ(NumOfTransfers(**first.Generate()), 0);
+	EXPECT_DOUBLE_EQ(first.PlanCost(), 11.0);
+	EXPECT_EQ(NumOfTransfers(**total.Generate()), 1);
+	EXPECT_DOUBLE_EQ(total.PlanCost(), 5.0);
+	makespan.Generate();
+	EXPECT_DOUBLE_EQ(makespan.PlanCost(), 4.0);
+}
+
+TEST(Controller, CheapestPlansOverRecipes) {
+	// Without annotations every step costs one, so no plan is cheaper than the fewest steps
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller breadth_first(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kBreadthFirst });
+		pcs::Controller cheapest(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kCheapest });
+		breadth_first.Generate();
+		cheapest.Generate();
+		EXPECT_GT(cheapest.PlanCost(), 0.0);
+		EXPECT_LE(cheapest.PlanCost(), breadth_first.PlanCost());
+	}
+}
+
+TEST(Controller, ParallelBranchesMatchSequential) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller sequential(&machine, machine.topology(), &recipe);
+		const auto& expected = **sequential.Generate();
+		for (size_t threads : { 2, 4 }) {
+			pcs::Controller parallel(&machine, machine.topology(), &recipe, { .threads = threads });
+			EXPECT_EQ(**parallel.Generate(), expected);
+		}
+	}
+
+	// Siblings after a failing recipe transition are left out, as the sequential controller never reaches them
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+	pcs::Controller sequential(&machine, machine.topology(), &recipe);
+	pcs::Controller parallel(&machine, machine.topology(), &recipe, { .threads = 4 });
+	EXPECT_EQ(**parallel.Generate(), **sequential.Generate());
+}
+
+TEST(Controller, SpeculativeSearchMatchesDepthFirst) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+
+		pcs::Controller depth_first(&machine, machine.topology(), &recipe, { .memoise = false });
+		const auto& expected = **depth_first.Generate();
+		for (size_t threads : { 1, 4 }) {
+			pcs::Controller speculative(&machine, machine.topology(), &recipe, { .memoise = false,
+				.search = pcs::SearchMode::kSpeculative, .search_threads = threads });
+			EXPECT_EQ(**speculative.Generate(), expected);
+		}
+
+		// Recipe workers share the speculative search threads out between them
+		pcs::Controller nested(&machine, machine.topology(), &recipe, { .memoise = false, .search = pcs::SearchMode::kSpeculative,
+			.threads = 2, .search_threads = 4 });
+		EXPECT_EQ(**nested.Generate(), expected);
+	}
+
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+	pcs::Controller speculative(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kSpeculative, .search_threads = 2 });
+	EXPECT_EQ((*speculative.Generate())->NumOfTransitions(), 0);
+}
+
+TEST(Controller, DecidesRealisability) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe branches("../../tests/controller/testdata/cycle/branches.json");
+	pcs::Recipe unrealisable("../../tests/controller/testdata/cycle/unrealisable.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &branches);
+	EXPECT_TRUE(controller.Decide().realisable);
+	size_t misses = controller.transpositions().misses();
+
+	pcs::Realisability result = controller.Decide(unrealisable);
+	EXPECT_FALSE(result.realisable);
+	EXPECT_EQ(result.from, "A");
+	EXPECT_EQ(result.to, "B");
+	EXPECT_EQ(result.transition, 0);
+	EXPECT_EQ(result.operation, "weld");
+
+	// The memoised searches carry over to later decisions, and no controller transitions were recorded
+	EXPECT_TRUE(controller.Decide().realisable);
+	EXPECT_EQ(controller.transpositions().misses(), misses + 1);
+	pcs::Controller generated(&machine, machine.topology(), &branches);
+	EXPECT_EQ(**controller.Generate(), **generated.Generate());
+
+	// A variant whose guard tests a resource which does not exist leaves the controller's own recipe in place
+	pcs::Recipe bad_guard("../../tests/controller/testdata/cycle/bad_guard.json");
+	pcs::Controller restored(&machine, machine.topology(), &branches);
+	EXPECT_THROW(restored.Decide(bad_guard), std::invalid_argument);
+	EXPECT_TRUE(restored.Decide().realisable);
+	pcs::Controller fresh(&machine, machine.topology(), &branches);
+	EXPECT_EQ(**restored.Generate(), **fresh.Generate());
+}
+
+TEST(Controller, SchedulesParallelOperations) {
+	// Resource1 could drill and then polish, but polishing on Resource2 at the same time takes one joint step
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/joint", 2);
+	pcs::Recipe finish("../../tests/controller/testdata/joint/finish.json");
+	pcs::Recipe twice("../../tests/controller/testdata/joint/twice.json");
+
+	for (pcs::SearchMode search : { pcs::SearchMode::kDepthFirst, pcs::SearchMode::kCheapest }) {
+		pcs::Controller controller(&machine, machine.topology(), &finish, { .search = search, .objective = pcs::CostObjective::kMakespan });
+		const auto& lts = **controller.Generate();
+		const auto& loaded = lts.states().at(lts.initial_state()).transitions_;
+		ASSERT_EQ(loaded.size(), 1);
+		EXPECT_EQ(loaded[0].label(), std::vector<std::string>({ "load", "-" }));
+		const auto& joint = lts.states().at(loaded[0].to()).transitions_;
+		ASSERT_EQ(joint.size(), 1);
+		EXPECT_EQ(joint[0].label(), std::vector<std::string>({ "drill", "polish" }));
+		EXPECT_EQ(joint[0].to(), std::vector<std::string>({ "s2", "t1" }));
+		EXPECT_DOUBLE_EQ(controller.PlanCost(), 2.0);
+	}
+
+	// Only Resource2 can polish from the initial state, and a parallel operation never waits on other operations
+	pcs::Controller controller(&machine, machine.topology(), &finish);
+	pcs::Realisability result = controller.Decide(twice);
+	EXPECT_FALSE(result.realisable);
+	EXPECT_EQ(result.operation, "polish");
+}
+
+TEST(Controller, GuardsDisableRecipeTransitions) {
+	// Only the drilling branch and the polishing after it are enabled, so the unrealisable welds are never searched
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/joint", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/joint/guards.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &recipe);
+	EXPECT_TRUE(controller.Decide().realisable);
+	EXPECT_EQ(controller.NumOfDisabledTransitions(), 3);
+
+	const auto& lts = **controller.Generate();
+	EXPECT_EQ(controller.NumOfDisabledTransitions(), 3);
+	size_t transitions = 0;
+	for (const auto& [key, state] : lts.states()) {
+		transitions += state.transitions_.size();
+		for (const auto& t : state.transitions_) {
+			EXPECT_EQ(std::count(t.label().begin(), t.label().end(), "weld"), 0);
+		}
+	}
+	EXPECT_EQ(transitions, 3);
+
+	pcs::Controller parallel(&machine, machine.topology(), &recipe, { .threads = 2 });
+	EXPECT_EQ(**parallel.Generate(), lts);
+	EXPECT_EQ(parallel.NumOfDisabledTransitions(), 3);
+}
+
+TEST(Controller, PrunesUnconnectedTransfers) {
+	// Only resource 4 can weld, so the transfers between resources 1 and 2 never help
+	pcs::Environment machine = LoadMachine("../../tests/environment/testdata/graph", 4);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+
+	pcs::Controller searched(&machine, machine.topology(), &recipe);
+	pcs::Controller pruned(&machine, machine.topology(), &recipe, { .prune_transfers = true });
+	const auto& lts = **pruned.Generate();
+	searched.Generate();
+	EXPECT_EQ(lts.NumOfTransitions(), 2);
+	EXPECT_GT(pruned.NumOfPrunedTransfers(), 0);
+	EXPECT_LE(pruned.NumOfExpansions(), searched.NumOfExpansions());
+
+	// Pruning never loses a plan
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+		pcs::Controller searched(&machine, machine.topology(), &recipe);
+		pcs::Controller pruned(&machine, machine.topology(), &recipe, { .prune_transfers = true });
+		EXPECT_EQ(pruned.Decide().realisable, searched.Decide().realisable);
+	}
+}
+
+TEST(Controller, ReachabilityIndexGuidesSearch) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+		pcs::ReachabilityIndex index(machine.topology()->lts());
+
+		pcs::Controller breadth_first(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kBreadthFirst });
+		pcs::Controller indexed(&machine, machine.topology(), &recipe, { .search = pcs::SearchMode::kAStar });
+		indexed.set_reachability_index(&index);
+		EXPECT_EQ(NumOfTransfers(**indexed.Generate()), NumOfTransfers(**breadth_first.Generate()));
+		EXPECT_LE(indexed.NumOfExpansions(), breadth_first.NumOfExpansions());
+	}
+
+	// Operations which cannot be reached fail without expanding any state
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/cycle", 2);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+	pcs::ReachabilityIndex index(machine.topology()->lts());
+	pcs::Controller controller(&machine, machine.topology(), &recipe);
+	controller.set_reachability_index(&index);
+	EXPECT_EQ((*controller.Generate())->NumOfTransitions(), 0);
+	EXPECT_EQ(controller.NumOfExpansions(), 0);
+}
\ No newline at end of file
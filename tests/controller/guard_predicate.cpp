@@ -0,0 +1,72 @@
+#include "pcs/controller/guard_predicate.h"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+static std::pair<pcs::Guard, std::vector<std::string>> MakeGuard(const std::string& name, const std::vector<std::string>& input) {
+	return { pcs::Guard(name), input };
+}
+
+TEST(GuardPredicate, Parts) {
+	auto names = std::make_shared<pcs::PartNames>();
+	pcs::GuardPredicate always(MakeGuard("", { "p" }), *names, 2);
+	pcs::GuardPredicate present(MakeGuard("check", { "p", "q" }), *names, 2);
+	pcs::GuardPredicate twice(MakeGuard("check", { "p", "p" }), *names, 2);
+	pcs::GuardPredicate absent(MakeGuard("absent", { "q" }), *names, 2);
+	const std::vector<std::string> state{ "s0", "t0" };
+
+	pcs::Parts parts(2, names);
+	EXPECT_EQ(always.kind(), pcs::GuardKind::kAlways);
+	EXPECT_TRUE(always.Holds(parts, state));
+	EXPECT_FALSE(present.Holds(parts, state));
+	EXPECT_TRUE(absent.Holds(parts, state));
+
+	// The parts may be spread over the resources, but repeated parts need as many copies
+	parts.Add({ 0, "load" }, { "p" });
+	parts.Add({ 1, "load" }, { "q" });
+	EXPECT_TRUE(present.Holds(parts, state));
+	EXPECT_FALSE(twice.Holds(parts, state));
+	EXPECT_FALSE(absent.Holds(parts, state));
+	parts.Add({ 1, "load" }, { "p" });
+	EXPECT_TRUE(twice.Holds(parts, state));
+}
+
+TEST(GuardPredicate, ConsumedParts) {
+	auto names = std::make_shared<pcs::PartNames>();
+	pcs::GuardPredicate present(MakeGuard("check", { "p" }), *names, 2);
+	pcs::GuardPredicate twice(MakeGuard("check", { "p", "p" }), *names, 2);
+	pcs::GuardPredicate absent(MakeGuard("absent", { "p" }), *names, 2);
+	const std::vector<std::string> state{ "s0", "t0" };
+
+	pcs::Parts parts(2, names);
+	parts.Add({ 0, "load" }, { "p" });
+	parts.Add({ 1, "load" }, { "p" });
+	EXPECT_TRUE(twice.Holds(parts, state));
+	EXPECT_FALSE(absent.Holds(parts, state));
+
+	// Guards only count the copies left once operations have consumed their inputs
+	size_t checkpoint = parts.Checkpoint();
+	EXPECT_TRUE(parts.Consume(0, { "p" }));
+	EXPECT_TRUE(present.Holds(parts, state));
+	EXPECT_FALSE(twice.Holds(parts, state));
+	EXPECT_FALSE(absent.Holds(parts, state));
+	EXPECT_TRUE(parts.Consume(0, { "p" }));
+	EXPECT_FALSE(present.Holds(parts, state));
+	EXPECT_TRUE(absent.Holds(parts, state));
+
+	parts.Rollback(checkpoint);
+	EXPECT_TRUE(twice.Holds(parts, state));
+}
+
+TEST(GuardPredicate, States) {
+	pcs::PartNames names;
+	pcs::GuardPredicate drilled(MakeGuard("1=t2", {}), names, 2);
+	pcs::Parts parts(2);
+	EXPECT_EQ(drilled.kind(), pcs::GuardKind::kPresent);
+	EXPECT_TRUE(drilled.Holds(parts, { "s0", "t2" }));
+	EXPECT_FALSE(drilled.Holds(parts, { "s0", "t0" }));
+	EXPECT_THROW(pcs::GuardPredicate(MakeGuard("2=t2", {}), names, 2), std::invalid_argument);
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include <vector>
+#include <memory>
 #include <unordered_set>
 
 TEST(Parts, Add) {
@@ -31,6 +32,24 @@ TEST(Parts, AllocateMissingParts) {
 	EXPECT_EQ(allocate, false);
 }
 
+TEST(Parts, Consume) {
+	pcs::Parts parts(3);
+	parts.Add({ 0, "add_op" }, { "d", "s", "s" });
+	parts.Add({ 1, "add_op" }, { "h" });
+
+	size_t checkpoint = parts.Checkpoint();
+	EXPECT_TRUE(parts.Consume(1, { "s", "h" }));
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "d", "s" }));
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>());
+
+	EXPECT_FALSE(parts.Consume(2, { "d", "h", "x" }));
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "s" }));
+
+	parts.Rollback(checkpoint);
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "d", "s", "s" }));
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>({ "h" }));
+}
+
 TEST(Parts, Synchronize) {
 	pcs::Parts parts(10), expected_parts(10);
 	std::pair<size_t, std::string> add_t(0, "add_op");
@@ -51,3 +70,80 @@ TEST(Parts, SynchronizeMissingParts) {
 	ASSERT_EQ(sync, false);
 }
 
+
+
+TEST(Parts, Rollback) {
+	pcs::Parts parts(3), expected(3);
+	parts.Add({ 0, "add_op" }, { "p1", "p2", "p3", "p4" });
+	expected.Add({ 0, "add_op" }, { "p1", "p2", "p3", "p4" });
+
+	size_t checkpoint = parts.Checkpoint();
+	parts.Synchronize(1, 0, { "p1", "p3" });
+	parts.Allocate({ 1, "allocate_op" }, { "p3" });
+	parts.Add({ 2, "add_op" }, { "p5" });
+	parts.Allocate({ 0, "allocate_op" }, { "p2", "p4" });
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>());
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>({ "p1" }));
+
+	parts.Rollback(checkpoint);
+	EXPECT_EQ(parts, expected);
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "p1", "p2", "p3", "p4" }));
+	EXPECT_EQ(parts.Checkpoint(), checkpoint);
+}
+
+TEST(Parts, Copies) {
+	pcs::Parts parts(2);
+	parts.Add({ 0, "add_op" }, { "h", "p", "h" });
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "h", "h", "p" }));
+
+	size_t checkpoint = parts.Checkpoint();
+	EXPECT_FALSE(parts.Allocate({ 0, "allocate_op" }, { "h" }));
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "p" }));
+	parts.Rollback(checkpoint);
+
+	EXPECT_TRUE(parts.Synchronize(1, 0, { "h", "h" }));
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>({ "h", "h" }));
+	parts.Rollback(checkpoint);
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "h", "h", "p" }));
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>());
+}
+
+TEST(Parts, SharedNames) {
+	auto names = std::make_shared<pcs::PartNames>();
+	names->Intern("p1");
+	names->Intern("p2");
+	pcs::Parts parts(2, names), other(2, names);
+	parts.Add({ 0, "add_op" }, { "p2", "p1" });
+	other.Add({ 0, "add_op" }, { "p1", "p2" });
+	EXPECT_EQ(parts, other);
+	EXPECT_EQ(parts.Canonical(), other.Canonical());
+
+	// Parts interned by another inventory widen the bitsets as needed
+	for (size_t i = 0; i < 100; ++i) {
+		other.Add({ 1, "add_op" }, { "q" + std::to_string(i) });
+	}
+	EXPECT_EQ(other.Count(1, *names->Find("q99")), 1u);
+	EXPECT_EQ(parts.Count(1, *names->Find("q99")), 0u);
+	EXPECT_NE(parts, other);
+	EXPECT_TRUE(other.Allocate({ 1, "allocate_op" }, { "q0", "q99" }));
+	EXPECT_FALSE(parts.Allocate({ 1, "allocate_op" }, { "q99" }));
+	EXPECT_EQ(other.AtResource(1).size(), 98u);
+}
+
+TEST(Parts, Fork) {
+	pcs::Parts parts(3);
+	parts.Add({ 0, "add_op" }, { "p1", "p2" });
+	pcs::Parts fork = parts.Fork();
+	EXPECT_EQ(fork, parts);
+	EXPECT_EQ(fork.Checkpoint(), 0);
+
+	fork.Add({ 1, "add_op" }, { "p3" });
+	EXPECT_TRUE(fork.Synchronize(2, 0, { "p1" }));
+	EXPECT_EQ(parts.AtResource(0), std::vector<std::string>({ "p1", "p2" }));
+	EXPECT_EQ(parts.AtResource(1), std::vector<std::string>());
+	EXPECT_EQ(fork.AtResource(0), std::vector<std::string>({ "p2" }));
+	EXPECT_EQ(fork.AtResource(2), std::vector<std::string>({ "p1" }));
+
+	fork.Rollback(0);
+	EXPECT_EQ(fork, parts);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "pcs/controller/plan_list.h"
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+static std::vector<std::string> Labels(const pcs::PlanList& plan, size_t count = SIZE_MAX) {
+	std::vector<std::string> labels;
+	plan.ForEach([&labels](const pcs::PlanTransition& plan_t) { labels.emplace_back(plan_t.label[0]); }, count);
+	return labels;
+}
+
+TEST(PlanList, Push) {
+	pcs::PlanList empty;
+	pcs::PlanList plan = empty.Push({ nullptr, { "a" }, nullptr }).Push({ nullptr, { "b" }, nullptr });
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(plan.size(), 2);
+	EXPECT_EQ(plan.front().label, std::vector<std::string>({ "b" }));
+	EXPECT_EQ(Labels(plan), std::vector<std::string>({ "a", "b" }));
+	EXPECT_EQ(Labels(plan.Pop()), std::vector<std::string>({ "a" }));
+	EXPECT_THROW(empty.Pop(), std::out_of_range);
+}
+
+TEST(PlanList, SharesPrefix) {
+	std::vector<pcs::PlanTransition> transitions{ { nullptr, { "a" }, nullptr }, { nullptr, { "b" }, nullptr } };
+	pcs::PlanList prefix(transitions);
+	pcs::PlanList left = prefix.Push({ nullptr, { "l" }, nullptr });
+	pcs::PlanList right = prefix.Push({ nullptr, { "r1" }, nullptr }).Push({ nullptr, { "r2" }, nullptr });
+
+	EXPECT_EQ(&left.Pop().front(), &prefix.front());
+	EXPECT_EQ(&right.Pop().Pop().front(), &prefix.front());
+	EXPECT_EQ(Labels(left), std::vector<std::string>({ "a", "b", "l" }));
+	EXPECT_EQ(Labels(right, right.size() - prefix.size()), std::vector<std::string>({ "r1", "r2" }));
+	EXPECT_EQ(prefix.ToVector().size(), 2);
+}
+
+TEST(PlanList, LongPlan) {
+	pcs::PlanList plan;
+	for (size_t i = 0; i < 1000000; ++i) {
+		plan = plan.Push({ nullptr, { "t" }, nullptr });
+	}
+	EXPECT_EQ(plan.size(), 1000000);
+}
\ No newline at end of file
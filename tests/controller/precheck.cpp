@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "pcs/controller/precheck.h"
+
+#include <string>
+
+#include "pcs/product/recipe.h"
+#include "pcs/environment/environment.h"
+#include "pcs/controller/controller.h"
+
+#include "common/resources.h"
+
+TEST(Precheck, PassesRealisableRecipes) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::Environment machine = LoadMachine("../../data/" + folder, 5, false);
+		pcs::Recipe recipe("../../data/" + folder + "/recipe.json");
+		EXPECT_TRUE(pcs::Prechecker(machine).Check(recipe).passed());
+	}
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/precheck", 2, false);
+	pcs::Recipe recipe("../../tests/controller/testdata/press.json");
+	EXPECT_TRUE(pcs::Prechecker(machine).Check(recipe).passed());
+}
+
+TEST(Precheck, UnknownOperation) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/precheck", 2, false);
+	pcs::Recipe recipe("../../tests/controller/testdata/cycle/unrealisable.json");
+
+	pcs::PrecheckResult result = pcs::Prechecker(machine).Check(recipe);
+	EXPECT_EQ(result.failure, pcs::PrecheckFailure::kUnknownOperation);
+	EXPECT_EQ(result.from, "A");
+	EXPECT_EQ(result.to, "B");
+	EXPECT_EQ(result.operation, "weld");
+}
+
+TEST(Precheck, UnreachableOperation) {
+	// Resource1 only drills after out:7, which no resource can take in
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/precheck", 2, false);
+	pcs::Recipe recipe("../../tests/controller/testdata/precheck/drill.json");
+
+	pcs::Prechecker prechecker(machine);
+	EXPECT_TRUE(prechecker.IsOffered("drill"));
+	EXPECT_FALSE(prechecker.IsReachable("drill"));
+	pcs::PrecheckResult result = prechecker.Check(recipe);
+	EXPECT_EQ(result.failure, pcs::PrecheckFailure::kUnreachableOperation);
+	EXPECT_EQ(result.operation, "drill");
+	EXPECT_TRUE(pcs::Prechecker(machine, { .channels = false }).Check(recipe).passed());
+}
+
+TEST(Precheck, UnproducedPart) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/precheck", 2, false);
+	pcs::Recipe recipe("../../tests/controller/testdata/precheck/parts.json");
+
+	pcs::PrecheckResult result = pcs::Prechecker(machine).Check(recipe);
+	EXPECT_EQ(result.failure, pcs::PrecheckFailure::kUnproducedPart);
+	EXPECT_EQ(result.operation, "press");
+	EXPECT_EQ(result.part, "pin");
+}
+
+TEST(Precheck, RejectsBeforeSearching) {
+	pcs::Environment machine = LoadMachine("../../tests/controller/testdata/precheck", 2, false);
+	machine.Complete();
+	pcs::Recipe recipe("../../tests/controller/testdata/precheck/drill.json");
+
+	pcs::Controller controller(&machine, machine.topology(), &recipe, { .precheck = true });
+	pcs::Realisability result = controller.Decide();
+	EXPECT_FALSE(result.realisable);
+	EXPECT_EQ(result.precheck, pcs::PrecheckFailure::kUnreachableOperation);
+	EXPECT_EQ(controller.NumOfExpansions(), 0);
+	EXPECT_FALSE(controller.Generate().has_value());
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "pcs/environment/prune.h"
+
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+#include "pcs/environment/environment.h"
+
+#include "common/resources.h"
+
+TEST(Prune, RemovesDeadUnreachableAndSelfLoops) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss(2);
+	ltss[0].set_initial_state("s0");
+	ltss[0].AddTransition("s0", "nop", "s0");
+	ltss[0].AddTransition("s0", "in:1", "s1");
+	ltss[0].AddTransition("s0", "in:9", "s2");
+	ltss[0].AddTransition("s1", "load", "s0");
+	ltss[0].AddTransition("s3", "store", "s0");
+	ltss[1].set_initial_state("s0");
+	ltss[1].AddTransition("s0", "out:1", "s0");
+
+	pcs::PruneStats stats = pcs::PruneResources(ltss);
+	EXPECT_EQ(stats.self_loops, 1);
+	EXPECT_EQ(stats.dead_transfers, 1);
+	EXPECT_EQ(stats.unreachable_states, 2);
+
+	pcs::LTS<std::string, std::string> expected("s0");
+	expected.AddTransition("s0", "in:1", "s1");
+	expected.AddTransition("s1", "load", "s0");
+	EXPECT_EQ(ltss[0], expected);
+	EXPECT_EQ(ltss[1].NumOfTransitions(), 1);
+}
+
+TEST(Prune, Cascades) {
+	// in:9 is dead, which strands s1 and with it the only partner of the other resource's in:1
+	std::vector<pcs::LTS<std::string, std::string>> ltss(2);
+	ltss[0].set_initial_state("s0");
+	ltss[0].AddTransition("s0", "in:9", "s1");
+	ltss[0].AddTransition("s1", "out:1", "s0");
+	ltss[1].set_initial_state("s0");
+	ltss[1].AddTransition("s0", "in:1", "s0");
+
+	pcs::PruneStats stats = pcs::PruneResources(ltss);
+	EXPECT_EQ(stats.dead_transfers, 2);
+	EXPECT_EQ(stats.unreachable_states, 1);
+	EXPECT_GE(stats.rounds, 2);
+	EXPECT_EQ(ltss[0].NumOfTransitions() + ltss[1].NumOfTransitions(), 0);
+}
+
+TEST(Prune, PreservesTopology) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/" + folder, 5);
+		pcs::CompleteTopology original(ltss);
+
+		std::vector<pcs::LTS<std::string, std::string>> pruned = ltss;
+		pcs::PruneResources(pruned, { .silent_self_loops = false });
+		pcs::CompleteTopology topology(pruned);
+		EXPECT_EQ(topology.lts(), original.lts());
+	}
+}
+
+TEST(Prune, Environment) {
+	pcs::Environment machine(LoadResources("../../data/hinge", 5), false);
+	pcs::PruneStats stats = machine.PruneResources();
+	// Resource4's s3 has no incoming transitions
+	EXPECT_EQ(stats.unreachable_states, 1);
+	EXPECT_GT(stats.self_loops, 0);
+	machine.Complete();
+
+	pcs::CompleteTopology original(LoadResources("../../data/hinge", 5));
+	EXPECT_EQ(machine.NumOfTopologyStates(), original.lts().NumOfStates());
+	EXPECT_LT(machine.topology()->lts().NumOfTransitions(), original.lts().NumOfTransitions());
+}
\ No newline at end of file
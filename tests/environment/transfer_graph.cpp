@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "pcs/environment/transfer_graph.h"
+
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+
+#include "common/resources.h"
+
+TEST(TransferGraph, ChannelsAndComponents) {
+	// Resources 1 and 2 pass parts back and forth, as do 3 and 4, but the pairs are not connected
+	pcs::TransferGraph graph(LoadResources("../../tests/environment/testdata/graph", 4));
+	EXPECT_EQ(graph.channels().size(), 4);
+	EXPECT_EQ(graph.NumOfComponents(), 2);
+	EXPECT_TRUE(graph.IsConnected(0, 1));
+	EXPECT_TRUE(graph.IsConnected(2, 3));
+	EXPECT_FALSE(graph.IsConnected(1, 2));
+
+	ASSERT_EQ(graph.Outgoing(2).size(), 1);
+	const pcs::TransferChannel& channel = graph.channels()[graph.Outgoing(2)[0]];
+	EXPECT_EQ(channel.to, 3);
+	EXPECT_EQ(channel.out_label, "out:1");
+	EXPECT_EQ(channel.in_label, "in:1");
+	EXPECT_EQ(channel.from_states, std::vector<std::string>({ "c0" }));
+	EXPECT_EQ(channel.to_states, std::vector<std::string>({ "d0" }));
+
+	EXPECT_EQ(graph.Distance(2, 3), 1);
+	EXPECT_EQ(graph.Distance(2, 2), 0);
+	EXPECT_EQ(graph.Distance(0, 3), pcs::TransferGraph::kNoRoute);
+	EXPECT_TRUE(graph.Route(0, 3).empty());
+}
+
+TEST(TransferGraph, ShortestRoutes) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		pcs::TransferGraph graph(LoadResources("../../data/" + folder, 5));
+		for (size_t from = 0; from < graph.NumOfResources(); ++from) {
+			for (size_t to = 0; to < graph.NumOfResources(); ++to) {
+				std::vector<size_t> route = graph.Route(from, to);
+				if (graph.Distance(from, to) == pcs::TransferGraph::kNoRoute) {
+					EXPECT_TRUE(route.empty());
+					continue;
+				}
+				ASSERT_EQ(route.size(), graph.Distance(from, to) + 1);
+				EXPECT_EQ(route.front(), from);
+				EXPECT_EQ(route.back(), to);
+				for (size_t i = 1; i < route.size(); ++i) {
+					EXPECT_EQ(graph.Distance(route[i - 1], route[i]), 1);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
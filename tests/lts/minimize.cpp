@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "pcs/lts/minimize.h"
+
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+#include "pcs/environment/environment.h"
+
+#include "common/resources.h"
+
+TEST(Minimize, MergesBisimilarStates) {
+	pcs::LTS<std::string, std::string> lts("s0");
+	lts.AddTransition("s0", "a", "s1");
+	lts.AddTransition("s0", "a", "s2");
+	lts.AddTransition("s1", "b", "s0");
+	lts.AddTransition("s2", "b", "s0");
+
+	pcs::MinimizeStats stats;
+	pcs::LTS<std::string, std::string> expected("s0");
+	expected.AddTransition("s0", "a", "s1");
+	expected.AddTransition("s1", "b", "s0");
+	EXPECT_EQ(pcs::Minimize(lts, {}, &stats), expected);
+	EXPECT_EQ(stats.states_before, 3);
+	EXPECT_EQ(stats.states_after, 2);
+	EXPECT_EQ(stats.transitions_after, 2);
+}
+
+TEST(Minimize, KeepsDistinguishableStates) {
+	pcs::LTS<std::string, std::string> lts("s0");
+	lts.AddTransition("s0", "a", "s1");
+	lts.AddTransition("s0", "a", "s2");
+	lts.AddTransition("s1", "b", "s0");
+	lts.AddTransition("s2", "c", "s0");
+	EXPECT_EQ(pcs::Minimize(lts), lts);
+}
+
+TEST(Minimize, BranchingDropsInertSilentSteps) {
+	pcs::LTS<std::string, std::string> lts("s0");
+	lts.AddTransition("s0", "nop", "s1");
+	lts.AddTransition("s1", "a", "s2");
+	lts.AddTransition("s2", "nop", "s2");
+
+	EXPECT_EQ(pcs::Minimize(lts).NumOfStates(), 3);
+
+	pcs::LTS<std::string, std::string> expected("s0");
+	expected.AddTransition("s0", "a", "s2");
+	expected.AddState("s2");
+	EXPECT_EQ(pcs::Minimize(lts, { .branching = true }), expected);
+}
+
+TEST(Minimize, BranchingKeepsSilentChoices) {
+	// The silent step discards the option of a, so s0 and s1 are not branching bisimilar
+	pcs::LTS<std::string, std::string> lts("s0");
+	lts.AddTransition("s0", "nop", "s1");
+	lts.AddTransition("s0", "a", "s2");
+	lts.AddTransition("s1", "b", "s2");
+	EXPECT_EQ(pcs::Minimize(lts, { .branching = true }), lts);
+}
+
+TEST(Minimize, Idempotent) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		for (const auto& lts : LoadResources("../../data/" + folder, 5)) {
+			for (bool branching : { false, true }) {
+				pcs::LTS<std::string, std::string> once = pcs::Minimize(lts, { .branching = branching });
+				EXPECT_LE(once.NumOfStates(), lts.NumOfStates());
+				EXPECT_EQ(pcs::Minimize(once, { .branching = branching }), once);
+			}
+		}
+	}
+}
+
+TEST(Minimize, EnvironmentShrinksTopology) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology original(ltss);
+
+	pcs::Environment machine(LoadResources("../../data/hinge", 5), false);
+	std::vector<pcs::MinimizeStats> stats = machine.MinimizeResources();
+	ASSERT_EQ(stats.size(), 5);
+	// Resource4's s2 and s3 both only return the part with out:4
+	EXPECT_EQ(stats[3].states_before, 4);
+	EXPECT_EQ(stats[3].states_after, 3);
+	machine.Complete();
+	EXPECT_LT(machine.NumOfTopologyStates(), original.lts().NumOfStates());
+	EXPECT_EQ(machine.topology()->initial_state(), original.initial_state());
+}
\ No newline at end of file
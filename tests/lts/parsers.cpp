@@ -30,4 +30,26 @@ TEST(ParseLTS, LTS1_JSON) {
 	expected.AddTransition("s1", "a2", "s2");
 
 	ASSERT_EQ(got, expected);
+}
+
+TEST(ParseLTS, Costs) {
+	for (bool is_json : { false, true }) {
+		pcs::LTS got;
+		pcs::TransitionCosts costs;
+		if (is_json) {
+			pcs::ReadFromJsonFile(got, "../../tests/lts/testdata/costs.json", &costs);
+		} else {
+			pcs::ReadFromFile(got, "../../tests/lts/testdata/costs.txt", &costs);
+		}
+
+		pcs::LTS expected;
+		expected.set_initial_state("s0", true);
+		expected.AddTransition("s0", "a1", "s1");
+		expected.AddTransition("s1", "a2", "s2");
+
+		ASSERT_EQ(got, expected);
+		EXPECT_EQ(costs.size(), 1);
+		EXPECT_DOUBLE_EQ(costs.Cost("s0", "a1", "s1"), 2.5);
+		EXPECT_DOUBLE_EQ(costs.Cost("s1", "a2", "s2"), pcs::TransitionCosts::kDefaultCost);
+	}
 }
\ No newline at end of file
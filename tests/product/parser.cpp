@@ -44,4 +44,14 @@ TEST(ProductParser, Recipe1) {
 	expected.AddTransition("A", co2, "E", true);
 
 	ASSERT_EQ(got, expected);
+}
+
+TEST(ProductParser, InternsPartNames) {
+	LTS<std::string, CompositeOperation> lts;
+	PartNames parts;
+	ReadFromJsonFile(lts, "../../tests/product/testdata/recipe1.json", &parts);
+
+	EXPECT_EQ(parts.names(), std::vector<std::string>({ "c", "f", "p", "h", "h2", "p0" }));
+	EXPECT_EQ(parts.Find("h2"), 4u);
+	EXPECT_FALSE(parts.Find("x").has_value());
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/external.h"
+
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/environment/environment.h"
+#include "pcs/common/external_sort.h"
+
+#include "common/resources.h"
+
+TEST(ExternalSorter, SortsUniqueAcrossRuns) {
+	std::filesystem::path directory = CleanDirectory("external-sort");
+	pcs::ExternalSorter sorter({ .record_words = 2, .key_words = 2, .unique = true, .buffer_bytes = 256, .directory = directory });
+	std::mt19937 rng(7);
+	std::vector<std::pair<uint32_t, uint32_t>> expected;
+	for (size_t i = 0; i < 2000; ++i) {
+		uint32_t record[2] = { rng() % 50, rng() % 20 };
+		sorter.Add(record);
+		expected.emplace_back(record[0], record[1]);
+	}
+	std::sort(expected.begin(), expected.end());
+	expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+	EXPECT_EQ(sorter.Finish(directory / "sorted.bin"), expected.size());
+	EXPECT_GT(sorter.NumOfRuns(), 1);
+	std::vector<std::pair<uint32_t, uint32_t>> sorted;
+	for (pcs::RecordReader reader(directory / "sorted.bin", 2); !reader.Done(); reader.Advance()) {
+		sorted.emplace_back(reader.Current()[0], reader.Current()[1]);
+	}
+	EXPECT_EQ(sorted, expected);
+}
+
+TEST(ExternalTopology, MatchesComplete) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/" + folder, 5);
+		pcs::CompleteTopology complete(ltss);
+		std::filesystem::path directory = CleanDirectory("external-" + folder);
+		// A tiny buffer forces every sort to spill and merge over several passes
+		pcs::ExternalStats stats = pcs::ExploreExternal(ltss, directory / "topology.pcst", { .directory = directory / "scratch", .buffer_bytes = 4096 });
+		std::unique_ptr<pcs::FrozenTopology> frozen = pcs::FrozenTopology::Load(directory / "topology.pcst");
+
+		EXPECT_EQ(stats.states, complete.lts().NumOfStates());
+		EXPECT_EQ(stats.transitions, complete.lts().NumOfTransitions());
+		EXPECT_GT(stats.runs, 0);
+		EXPECT_EQ(frozen->initial_state(), complete.initial_state());
+		EXPECT_EQ(frozen->at(complete.initial_state()), complete.at(complete.initial_state()));
+		EXPECT_EQ(frozen->lts(), complete.lts());
+		EXPECT_TRUE(std::filesystem::is_empty(directory / "scratch"));
+	}
+}
+
+TEST(ExternalTopology, Environment) {
+	std::filesystem::path directory = CleanDirectory("external-environment");
+	pcs::Environment environment(LoadResources("../../data/hinge", 5), false);
+	pcs::ExternalStats stats = environment.External({ .directory = directory });
+	pcs::CompleteTopology complete(environment.resources());
+
+	EXPECT_EQ(stats.states, 342);
+	EXPECT_NE(dynamic_cast<pcs::FrozenTopology*>(environment.topology()), nullptr);
+	EXPECT_EQ(environment.topology()->lts(), complete.lts());
+}
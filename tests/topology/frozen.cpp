@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/frozen.h"
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <filesystem>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/cache.h"
+#include "pcs/topology/renumber.h"
+#include "pcs/environment/environment.h"
+#include "pcs/common/shared_memory.h"
+
+#include "common/resources.h"
+
+TEST(FrozenTopology, FreezeMatchesComplete) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::FrozenTopology frozen(complete.lts());
+
+	EXPECT_EQ(frozen.NumOfStates(), complete.lts().NumOfStates());
+	EXPECT_EQ(frozen.NumOfTransitions(), complete.lts().NumOfTransitions());
+	EXPECT_EQ(frozen.initial_state(), complete.initial_state());
+	EXPECT_EQ(frozen.at(complete.initial_state()), complete.at(complete.initial_state()));
+	EXPECT_EQ(frozen.lts(), complete.lts());
+}
+
+TEST(FrozenTopology, WriteAndLoad) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	pcs::CompleteTopology complete(ltss);
+	std::filesystem::path path = CleanDirectory("frozen") / "pad.pcst";
+	pcs::FrozenTopology(complete.lts(), 42).Write(path);
+
+	std::unique_ptr<pcs::FrozenTopology> loaded = pcs::FrozenTopology::Load(path);
+	EXPECT_EQ(loaded->content_hash(), 42);
+	for (const auto& [key, state] : complete.lts().states()) {
+		std::optional<pcs::FrozenTopology::StateId> id = loaded->Find(key);
+		ASSERT_TRUE(id.has_value());
+		EXPECT_EQ(loaded->Key(*id), key);
+		EXPECT_EQ(loaded->Edges(*id).size(), state.transitions().size());
+	}
+	EXPECT_FALSE(loaded->Find(std::vector<std::string>(5, "missing")).has_value());
+	EXPECT_EQ(loaded->lts(), complete.lts());
+}
+
+TEST(FrozenTopology, RejectsCorruptOffsets) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::FrozenTopology frozen(complete.lts());
+	pcs::FrozenTopology::Header header;
+	std::memcpy(&header, frozen.bytes().data(), sizeof(header));
+
+	auto corrupt = [&](uint64_t offset, uint64_t value) {
+		std::vector<std::byte> bytes(frozen.bytes().begin(), frozen.bytes().end());
+		std::memcpy(bytes.data() + offset, &value, sizeof(value));
+		return bytes;
+	};
+	EXPECT_NO_THROW(pcs::FrozenTopology(corrupt(header.edge_offsets, 0)));
+	EXPECT_THROW(pcs::FrozenTopology(corrupt(header.edge_offsets + sizeof(uint64_t), UINT32_MAX)), std::runtime_error);
+	EXPECT_THROW(pcs::FrozenTopology(corrupt(header.string_offsets + sizeof(uint64_t), UINT32_MAX)), std::runtime_error);
+	EXPECT_THROW(pcs::FrozenTopology(corrupt(header.edges, UINT32_MAX)), std::runtime_error);
+}
+
+TEST(TopologyCache, MissStoreHit) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::TopologyCache cache(CleanDirectory("cache"));
+	EXPECT_EQ(cache.Load(ltss), nullptr);
+
+	pcs::CompleteTopology complete(ltss);
+	ASSERT_TRUE(cache.Store(ltss, complete));
+	std::unique_ptr<pcs::FrozenTopology> cached = cache.Load(ltss);
+	ASSERT_NE(cached, nullptr);
+	EXPECT_EQ(cached->lts(), complete.lts());
+
+	ltss[0].AddTransition("s3", "nop", "s3");
+	EXPECT_EQ(cache.Load(ltss), nullptr);
+}
+
+TEST(TopologyCache, EnvironmentComplete) {
+	pcs::Environment machine(LoadResources("../../data/hinge", 5), false);
+	machine.set_topology_cache(CleanDirectory("environment"));
+	machine.Complete();
+	EXPECT_NE(dynamic_cast<pcs::CompleteTopology*>(machine.topology()), nullptr);
+	auto expected = machine.topology()->lts();
+
+	machine.Complete();
+	EXPECT_NE(dynamic_cast<pcs::FrozenTopology*>(machine.topology()), nullptr);
+	EXPECT_EQ(machine.topology()->lts(), expected);
+}
+
+TEST(SharedTopology, PublishAndAttach) {
+	pcs::Environment publisher(LoadResources("../../data/hinge", 5), true);
+	pcs::SharedMemory segment = publisher.PublishTopology("pcs-tests-hinge");
+
+	pcs::Environment worker(LoadResources("../../data/hinge", 5), false);
+	worker.AttachTopology("pcs-tests-hinge");
+	EXPECT_NE(dynamic_cast<pcs::FrozenTopology*>(worker.topology()), nullptr);
+	EXPECT_EQ(worker.topology()->at(worker.topology()->initial_state()), publisher.topology()->at(publisher.topology()->initial_state()));
+	EXPECT_EQ(worker.topology()->lts(), publisher.topology()->lts());
+
+	pcs::Environment other(LoadResources("../../data/pad", 5), false);
+	EXPECT_THROW(other.AttachTopology("pcs-tests-hinge"), std::runtime_error);
+	pcs::SharedMemory::Remove("pcs-tests-hinge");
+}
+
+#ifndef _WIN32
+TEST(SharedTopology, RepublishKeepsAttachedSegment) {
+	pcs::SharedMemory first = pcs::SharedMemory::Create("pcs-tests-republish", 16);
+	std::memset(first.mutable_data(), 1, first.size());
+	pcs::SharedMemory attached = pcs::SharedMemory::Open("pcs-tests-republish");
+
+	pcs::SharedMemory second = pcs::SharedMemory::Create("pcs-tests-republish", 4096);
+	std::memset(second.mutable_data(), 2, second.size());
+	EXPECT_EQ(attached.size(), 16);
+	EXPECT_EQ(attached.data()[15], std::byte{ 1 });
+
+	pcs::SharedMemory reattached = pcs::SharedMemory::Open("pcs-tests-republish");
+	EXPECT_EQ(reattached.size(), 4096);
+	EXPECT_EQ(reattached.data()[4095], std::byte{ 2 });
+	EXPECT_TRUE(pcs::SharedMemory::Remove("pcs-tests-republish"));
+}
+#endif
+
+TEST(FrozenTopology, Renumber) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::FrozenTopology frozen(complete.lts());
+	pcs::LocalityStats hashed = pcs::MeasureLocality(frozen);
+
+	for (auto order : { pcs::StateOrder::kBreadthFirst, pcs::StateOrder::kDepthFirst, pcs::StateOrder::kReverseCuthillMcKee }) {
+		std::unique_ptr<pcs::FrozenTopology> renumbered = pcs::Renumber(frozen, order);
+		EXPECT_EQ(renumbered->NumOfStates(), frozen.NumOfStates());
+		EXPECT_EQ(renumbered->initial_state(), frozen.initial_state());
+		EXPECT_EQ(renumbered->lts(), complete.lts());
+		EXPECT_LT(pcs::MeasureLocality(*renumbered).mean_distance, hashed.mean_distance);
+	}
+	EXPECT_EQ(pcs::Renumber(frozen, pcs::StateOrder::kBreadthFirst)->initial_id(), 0);
+
+	std::vector<pcs::FrozenTopology::StateId> duplicate(frozen.NumOfStates(), 0);
+	EXPECT_THROW(frozen.Permute(duplicate), std::invalid_argument);
+}
\ No newline at end of file
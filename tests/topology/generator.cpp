@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/generator.h"
+
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+
+#include "common/resources.h"
+
+TEST(GeneratorTopology, ExploreMatchesComplete) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::GeneratorTopology generator(ltss);
+
+	pcs::ExplorationStats stats = generator.Explore();
+	EXPECT_EQ(stats.states, complete.lts().NumOfStates());
+	EXPECT_EQ(stats.transitions, complete.lts().NumOfTransitions());
+	for (const auto& [key, state] : complete.lts().states()) {
+		EXPECT_TRUE(generator.Visited(key));
+	}
+}
+
+TEST(GeneratorTopology, SuccessorsMatchComplete) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::GeneratorTopology generator(ltss);
+
+	for (const auto& [key, state] : complete.lts().states()) {
+		std::vector<std::string> next = key;
+		size_t i = 0;
+		for (const auto& successor : generator.Successors(key)) {
+			ASSERT_LT(i, state.transitions().size());
+			generator.Apply(next, successor);
+			EXPECT_EQ(state.transitions()[i].label(), std::make_pair(successor.resource, *successor.label));
+			EXPECT_EQ(state.transitions()[i].to(), next);
+			generator.Undo(next, successor);
+			EXPECT_EQ(next, key);
+			++i;
+		}
+		EXPECT_EQ(i, state.transitions().size());
+	}
+}
+
+TEST(GeneratorTopology, AtMaterialisesSingleState) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::GeneratorTopology generator(ltss);
+
+	const auto& state = generator.at(generator.initial_state());
+	EXPECT_EQ(state, complete.at(complete.initial_state()));
+	EXPECT_EQ(generator.lts().NumOfStates(), 1);
+}
+
+TEST(GeneratorTopology, BitstateExplore) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::GeneratorTopology generator(ltss);
+
+	pcs::BitStateSet visited(1 << 20);
+	pcs::ExplorationStats stats = generator.Explore(visited);
+	EXPECT_EQ(stats.states, complete.lts().NumOfStates());
+	EXPECT_EQ(visited.NumOfInserted(), stats.states);
+	EXPECT_GT(stats.coverage, 0.999);
+	EXPECT_EQ(generator.NumOfVisited(), 0);
+
+	// A saturated bit array loses states, and the estimate reflects it
+	pcs::BitStateSet tiny(8, 2);
+	pcs::ExplorationStats partial = generator.Explore(tiny);
+	EXPECT_LT(partial.states, complete.lts().NumOfStates());
+	EXPECT_LT(partial.coverage, stats.coverage);
+}
\ No newline at end of file
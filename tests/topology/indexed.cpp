@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/indexed.h"
+
+#include <tuple>
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+
+#include "common/resources.h"
+
+TEST(IndexedResources, SuccessorsMatchComplete) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::IndexedResources indexed(ltss);
+
+	EXPECT_EQ(indexed.Names(indexed.InitialKey().data()), complete.initial_state());
+	for (const auto& [key, state] : complete.lts().states()) {
+		std::vector<uint32_t> ids = *indexed.Ids(key);
+		size_t i = 0;
+		indexed.ForEachSuccessor(ids.data(), [&](size_t resource, uint32_t label, uint32_t to, size_t partner, uint32_t partner_to) {
+			std::vector<uint32_t> next = ids;
+			next[resource] = to;
+			if (partner != pcs::IndexedResources::kNone) {
+				next[partner] = partner_to;
+			}
+			ASSERT_LT(i, state.transitions().size());
+			EXPECT_EQ(state.transitions()[i].label(), std::make_pair(resource, indexed.Label(label)));
+			EXPECT_EQ(state.transitions()[i].to(), indexed.Names(next.data()));
+			++i;
+		});
+		EXPECT_EQ(i, state.transitions().size());
+	}
+}
+
+TEST(IndexedResources, ExpandBatchMatchesSuccessors) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::IndexedResources indexed(ltss);
+
+	pcs::StateBlock block(indexed.NumOfResources());
+	for (const auto& [key, state] : complete.lts().states()) {
+		block.push_back(indexed.Ids(key)->data());
+	}
+	pcs::EdgeBlock edges(indexed.NumOfResources());
+	indexed.ExpandBatch(block, edges);
+
+	// Per source state, the batch edges must be the single state successors in order
+	std::vector<std::vector<std::tuple<uint32_t, uint32_t, std::vector<uint32_t>>>> batched(block.size());
+	std::vector<uint32_t> target(indexed.NumOfResources());
+	for (size_t e = 0; e < edges.size(); ++e) {
+		edges.targets.Row(e, target.data());
+		batched[edges.source[e]].emplace_back(edges.resource[e], edges.label[e], target);
+	}
+	std::vector<uint32_t> key(indexed.NumOfResources());
+	for (size_t i = 0; i < block.size(); ++i) {
+		block.Row(i, key.data());
+		std::vector<std::tuple<uint32_t, uint32_t, std::vector<uint32_t>>> single;
+		indexed.ForEachSuccessor(key.data(), [&](size_t resource, uint32_t label, uint32_t to, size_t partner, uint32_t partner_to) {
+			std::vector<uint32_t> next = key;
+			next[resource] = to;
+			if (partner != pcs::IndexedResources::kNone) {
+				next[partner] = partner_to;
+			}
+			single.emplace_back(static_cast<uint32_t>(resource), label, next);
+		});
+		EXPECT_EQ(batched[i], single);
+	}
+	EXPECT_EQ(edges.size(), complete.lts().NumOfTransitions());
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/reachability.h"
+
+#include <vector>
+#include <string>
+#include <unordered_set>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/core.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/frozen.h"
+#include "pcs/topology/incremental.h"
+
+#include "common/resources.h"
+
+/*
+ * @brief Forward breadth first search over transfers to a state where the operation is enabled
+ */
+static uint32_t ForwardDistance(const pcs::ReachabilityIndex::TopologyLTS& lts, const std::vector<std::string>& start,
+	const std::string& operation) {
+	std::vector<const std::vector<std::string>*> layer = { &start };
+	std::unordered_set<std::vector<std::string>, boost::hash<std::vector<std::string>>> seen = { start };
+	for (uint32_t distance = 0; !layer.empty(); ++distance) {
+		std::vector<const std::vector<std::string>*> next;
+		for (const auto* state : layer) {
+			for (const auto& t : lts.states().at(*state).transitions_) {
+				if (t.label().second == operation) {
+					return distance;
+				}
+				if (pcs::IsTransferLabel(t.label().second) && seen.insert(t.to()).second) {
+					next.emplace_back(&t.to());
+				}
+			}
+		}
+		layer = std::move(next);
+	}
+	return pcs::ReachabilityIndex::kUnreachable;
+}
+
+TEST(ReachabilityIndex, MatchesForwardSearch) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/" + folder, 5);
+		pcs::CompleteTopology complete(ltss);
+		pcs::ReachabilityIndex index(complete.lts());
+		pcs::FrozenTopology frozen(complete.lts());
+		pcs::ReachabilityIndex frozen_index(frozen);
+		EXPECT_EQ(index.NumOfStates(), complete.lts().NumOfStates());
+		EXPECT_EQ(frozen_index.NumOfOperations(), index.NumOfOperations());
+
+		for (const std::string operation : { "load", "press", "store", "remove" }) {
+			for (const auto& [key, state] : complete.lts().states()) {
+				uint32_t expected = ForwardDistance(complete.lts(), key, operation);
+				EXPECT_EQ(index.Distance(*index.Find(key), operation), expected);
+				EXPECT_EQ(frozen_index.Distance(*frozen.Find(key), operation), expected);
+			}
+		}
+		EXPECT_EQ(index.Distance(0, "weld"), pcs::ReachabilityIndex::kUnreachable);
+	}
+}
+
+TEST(ReachabilityIndex, PerResourceDistances) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::ReachabilityIndex index(complete.lts());
+
+	pcs::ReachabilityIndex::StateId initial = *index.Find(complete.initial_state());
+	std::vector<size_t> capable = index.Capable(initial, "load");
+	ASSERT_FALSE(capable.empty());
+	uint32_t nearest = pcs::ReachabilityIndex::kUnreachable;
+	for (size_t r : capable) {
+		nearest = std::min(nearest, index.Distance(initial, r, "load"));
+	}
+	EXPECT_EQ(nearest, index.Distance(initial, "load"));
+}
+
+TEST(ReachabilityIndex, IncrementalUpdates) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::ReachabilityIndex expected(complete.lts());
+
+	// Expanding every state of the incremental topology reaches the same distances
+	pcs::IncrementalTopology incremental(ltss);
+	pcs::ReachabilityIndex index(ltss.size());
+	incremental.set_reachability_index(&index);
+	std::vector<std::vector<std::string>> stack = { incremental.initial_state() };
+	std::unordered_set<std::vector<std::string>, boost::hash<std::vector<std::string>>> seen = { incremental.initial_state() };
+	while (!stack.empty()) {
+		std::vector<std::string> key = std::move(stack.back());
+		stack.pop_back();
+		for (const auto& t : incremental.at(key).transitions_) {
+			// States not expanded yet are unknown, and so are the distances of those with transfers into them
+			if (!incremental.lts().states().contains(t.to())) {
+				EXPECT_FALSE(index.Find(t.to()).has_value());
+				if (pcs::IsTransferLabel(t.label().second)) {
+					EXPECT_EQ(index.Distance(*index.Find(key), "remove"), pcs::ReachabilityIndex::kUnknown);
+				}
+			}
+			if (seen.insert(t.to()).second) {
+				stack.emplace_back(t.to());
+			}
+		}
+	}
+	EXPECT_EQ(index.NumOfStates(), expected.NumOfStates());
+	for (const std::string operation : { "load", "press", "store", "remove" }) {
+		for (const auto& [key, state] : complete.lts().states()) {
+			EXPECT_EQ(index.Distance(*index.Find(key), operation), expected.Distance(*expected.Find(key), operation));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/static.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/incremental.h"
+#include "pcs/environment/environment.h"
+
+#include "common/resources.h"
+
+TEST(StaticTopology, CompleteMatchesComplete) {
+	for (const std::string folder : { "hinge", "pad" }) {
+		std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/" + folder, 5);
+		pcs::CompleteTopology complete(ltss);
+		pcs::StaticTopology<5> topology(ltss, false);
+
+		EXPECT_EQ(topology.NumOfStates(), complete.lts().NumOfStates());
+		EXPECT_EQ(topology.NumOfTransitions(), complete.lts().NumOfTransitions());
+		EXPECT_EQ(topology.initial_state(), complete.initial_state());
+		EXPECT_EQ(topology.lts(), complete.lts());
+	}
+}
+
+TEST(StaticTopology, IncrementalMatchesIncremental) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(ltss);
+	pcs::IncrementalTopology incremental(ltss);
+	pcs::StaticTopology<5> topology(ltss, true);
+
+	EXPECT_EQ(topology.lts(), incremental.lts());
+	for (const auto& [key, state] : complete.lts().states()) {
+		EXPECT_EQ(topology.at(key), incremental.at(key));
+	}
+	EXPECT_EQ(topology.lts(), incremental.lts());
+	EXPECT_THROW(topology.at({ "x", "x", "x", "x", "x" }), std::out_of_range);
+}
+
+TEST(StaticTopology, Dispatch) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/pad", 5);
+	EXPECT_NE(dynamic_cast<pcs::StaticTopology<5>*>(pcs::MakeStaticTopology(ltss, false).get()), nullptr);
+
+	// Beyond the specialised sizes the dynamic topologies are used
+	std::vector<pcs::LTS<std::string, std::string>> many(pcs::kMaxStaticResources + 1, ltss[0]);
+	EXPECT_NE(dynamic_cast<pcs::IncrementalTopology*>(pcs::MakeStaticTopology(many, true).get()), nullptr);
+
+	std::vector<pcs::LTS<std::string, std::string>> hinge = LoadResources("../../data/hinge", 5);
+	pcs::CompleteTopology complete(hinge);
+	pcs::Environment environment(hinge, false);
+	environment.Static(false);
+	EXPECT_EQ(environment.NumOfTopologyStates(), complete.lts().NumOfStates());
+	EXPECT_EQ(environment.topology()->lts(), complete.lts());
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "pcs/topology/strategy.h"
+
+#include <vector>
+#include <string>
+
+#include "pcs/lts/lts.h"
+#include "pcs/lts/parsers/string_string.h"
+#include "pcs/product/recipe.h"
+#include "pcs/topology/complete.h"
+#include "pcs/topology/incremental.h"
+#include "pcs/topology/generator.h"
+#include "pcs/environment/environment.h"
+
+#include "common/resources.h"
+
+TEST(Strategy, ExhaustiveSampleIsExact) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::Recipe recipe("../../data/hinge/recipe.json");
+	pcs::CompleteTopology complete(ltss);
+
+	pcs::StrategyStats stats = pcs::ChooseStrategy(ltss, recipe, { .sample_states = 1024 });
+	EXPECT_TRUE(stats.exact);
+	EXPECT_EQ(stats.sampled_states, complete.lts().NumOfStates());
+	EXPECT_EQ(stats.estimated_transitions, complete.lts().NumOfTransitions());
+	EXPECT_EQ(stats.strategy, pcs::TopologyStrategy::kComplete);
+	EXPECT_GT(stats.footprint, 0);
+	EXPECT_LE(stats.footprint, 5);
+	EXPECT_FALSE(stats.reason.empty());
+}
+
+TEST(Strategy, ProductBoundsPartialSample) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::Recipe recipe("../../data/hinge/recipe.json");
+
+	pcs::StrategyStats stats = pcs::ChooseStrategy(ltss, recipe, { .sample_states = 16 });
+	EXPECT_FALSE(stats.exact);
+	EXPECT_EQ(stats.sampled_states, 16);
+	EXPECT_EQ(stats.estimated_states, 4 * 3 * 3 * 4 * 5);
+	EXPECT_GT(stats.branching_factor, 0.0);
+}
+
+TEST(Strategy, Thresholds) {
+	std::vector<pcs::LTS<std::string, std::string>> ltss = LoadResources("../../data/hinge", 5);
+	pcs::Recipe recipe("../../data/hinge/recipe.json");
+
+	EXPECT_EQ(pcs::ChooseStrategy(ltss, recipe, { .complete_states = 10 }).strategy, pcs::TopologyStrategy::kIncremental);
+	EXPECT_EQ(pcs::ChooseStrategy(ltss, recipe, { .complete_states = 10, .generator_transitions = 100 }).strategy,
+		pcs::TopologyStrategy::kGenerator);
+}
+
+TEST(Strategy, EnvironmentAppliesChoice) {
+	pcs::Recipe recipe("../../data/hinge/recipe.json");
+	pcs::Environment machine(LoadResources("../../data/hinge", 5), false);
+
+	EXPECT_EQ(machine.Adaptive(recipe).strategy, pcs::TopologyStrategy::kComplete);
+	EXPECT_NE(dynamic_cast<pcs::CompleteTopology*>(machine.topology()), nullptr);
+
+	EXPECT_EQ(machine.Adaptive(recipe, { .complete_states = 10 }).strategy, pcs::TopologyStrategy::kIncremental);
+	EXPECT_NE(dynamic_cast<pcs::IncrementalTopology*>(machine.topology()), nullptr);
+
+	EXPECT_EQ(machine.Adaptive(recipe, { .complete_states = 10, .generator_transitions = 100 }).strategy, pcs::TopologyStrategy::kGenerator);
+	EXPECT_NE(dynamic_cast<pcs::GeneratorTopology*>(machine.topology()), nullptr);
+}
\ No newline at end of file